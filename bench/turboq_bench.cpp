@@ -0,0 +1,411 @@
+/*
+ * Copyright 2025 Denis Silko
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file turboq_bench.cpp
+ * @brief Hot-path benchmarks for ThreadPool, Queue and Timer.
+ *
+ * Every benchmark collects per-operation samples in nanoseconds and prints
+ * one record with count, mean, p50, p99, p999 and max, as JSON (default) or
+ * CSV, so that results can be diffed between releases.
+ *
+ * Usage: turboq_bench [--format=json|csv] [--filter=substring] [--scale=N]
+ */
+
+#include <TurboQ/turboq.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace turboq;
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+struct Config {
+    bool csv = false;
+    std::string filter;
+    size_t scale = 1;  ///< Multiplies iteration counts.
+};
+
+struct Result {
+    std::string name;
+    std::vector<double> samples;  ///< Nanoseconds per operation.
+};
+
+double elapsed_ns(Clock::time_point start, Clock::time_point end) {
+    return std::chrono::duration<double, std::nano>(end - start).count();
+}
+
+double percentile(const std::vector<double>& sorted, double q) {
+    if (sorted.empty())
+        return 0.0;
+    size_t rank = static_cast<size_t>(q * static_cast<double>(sorted.size() - 1) + 0.5);
+    return sorted[std::min(rank, sorted.size() - 1)];
+}
+
+void report(const Config& config, Result result, bool& first) {
+    auto& samples = result.samples;
+    std::sort(samples.begin(), samples.end());
+    double sum = 0.0;
+    for (double sample : samples) {
+        sum += sample;
+    }
+    double mean = samples.empty() ? 0.0 : sum / static_cast<double>(samples.size());
+    double max = samples.empty() ? 0.0 : samples.back();
+
+    if (config.csv) {
+        if (first)
+            std::printf("name,count,mean_ns,p50_ns,p99_ns,p999_ns,max_ns\n");
+        std::printf("%s,%zu,%.1f,%.1f,%.1f,%.1f,%.1f\n", result.name.c_str(), samples.size(), mean,
+                    percentile(samples, 0.5), percentile(samples, 0.99), percentile(samples, 0.999), max);
+    } else {
+        std::printf("%s  {\"name\": \"%s\", \"count\": %zu, \"mean_ns\": %.1f, \"p50_ns\": %.1f, "
+                    "\"p99_ns\": %.1f, \"p999_ns\": %.1f, \"max_ns\": %.1f}",
+                    first ? "[\n" : ",\n", result.name.c_str(), samples.size(), mean,
+                    percentile(samples, 0.5), percentile(samples, 0.99), percentile(samples, 0.999), max);
+    }
+    std::fflush(stdout);
+    first = false;
+}
+
+/**
+ * @brief Throughput of empty tasks submitted from outside the pool.
+ *
+ * One sample per round: round time divided by the number of tasks.
+ */
+Result submit_throughput(const Config& config, size_t threads) {
+    const size_t tasks = 100000 * config.scale;
+    const size_t rounds = 20;
+
+    ThreadPool pool(threads);
+    Result result{"submit_throughput/threads:" + std::to_string(threads), {}};
+
+    for (size_t round = 0; round < rounds; round++) {
+        std::atomic<size_t> done{0};
+        auto start = Clock::now();
+        for (size_t i = 0; i < tasks; i++) {
+            pool.submit([&] { done.fetch_add(1, std::memory_order_relaxed); });
+        }
+        while (done.load(std::memory_order_acquire) != tasks) {
+            std::this_thread::yield();
+        }
+        result.samples.push_back(elapsed_ns(start, Clock::now()) / static_cast<double>(tasks));
+    }
+    return result;
+}
+
+/**
+ * @brief Submit-to-start latency of single tasks separated by short gaps.
+ *
+ * With @p spin_count 0 the worker parks between tasks and every submit pays
+ * a wake; otherwise it is still polling when the next task arrives.
+ */
+Result wake_latency(const Config& config, size_t spin_count) {
+    const size_t iterations = 20000 * config.scale;
+
+    ThreadPool::Options options;
+    options.threads = 1;
+    options.spin_count = spin_count;
+    options.yield_count = spin_count ? 8 : 0;
+    ThreadPool pool(options);
+    Result result{spin_count ? "wake_latency/spin" : "wake_latency/park", {}};
+    result.samples.reserve(iterations);
+
+    for (size_t i = 0; i < iterations; i++) {
+        std::atomic<bool> started{false};
+        Clock::time_point start_time;
+        auto submitted = Clock::now();
+        pool.submit([&] {
+            start_time = Clock::now();
+            started.store(true, std::memory_order_release);
+        });
+        while (!started.load(std::memory_order_acquire)) {
+            std::this_thread::yield();
+        }
+        result.samples.push_back(elapsed_ns(submitted, start_time));
+
+        // A short pause, well inside the polling window, like a bursty producer.
+        auto until = Clock::now() + std::chrono::microseconds(2);
+        while (Clock::now() < until) {}
+    }
+    return result;
+}
+
+/**
+ * @brief Round trip between two serial queues that post to each other.
+ */
+Result serial_ping_pong(const Config& config) {
+    const size_t iterations = 20000 * config.scale;
+
+    Queue ping("bench_ping", Queue::Type::Serial, ThreadPool::QoS::UserInitiated);
+    Queue pong("bench_pong", Queue::Type::Serial, ThreadPool::QoS::UserInitiated);
+    Result result{"serial_ping_pong", {}};
+    result.samples.reserve(iterations);
+
+    std::mutex mutex;
+    std::condition_variable cv;
+    bool finished = false;
+    Clock::time_point sent;
+    size_t remaining = iterations;
+
+    std::function<void()> serve;
+    serve = [&] {
+        sent = Clock::now();
+        pong.async([&] {
+            ping.async([&] {
+                result.samples.push_back(elapsed_ns(sent, Clock::now()));
+                if (--remaining > 0) {
+                    serve();
+                    return;
+                }
+                std::lock_guard<std::mutex> lock(mutex);
+                finished = true;
+                cv.notify_one();
+            });
+        });
+    };
+
+    ping.async([&] { serve(); });
+
+    std::unique_lock<std::mutex> lock(mutex);
+    cv.wait(lock, [&] { return finished; });
+    return result;
+}
+
+/**
+ * @brief Cost of Queue::sync with an empty task.
+ */
+Result sync_round_trip(const Config& config, Queue::Type type) {
+    const size_t iterations = 20000 * config.scale;
+
+    Queue queue("bench_sync", type, ThreadPool::QoS::UserInitiated);
+    Result result{type == Queue::Type::Serial ? "sync_round_trip/serial" : "sync_round_trip/concurrent", {}};
+    result.samples.reserve(iterations);
+
+    for (size_t i = 0; i < iterations; i++) {
+        auto start = Clock::now();
+        queue.sync([] {});
+        result.samples.push_back(elapsed_ns(start, Clock::now()));
+    }
+    return result;
+}
+
+const char* backend_name(Timer::Backend backend) {
+    return backend == Timer::Backend::Wheel ? "wheel" : "heap";
+}
+
+/**
+ * @brief Cost of inserting a timer far in the future.
+ *
+ * One sample per batch of inserts; the timers are cancelled afterwards.
+ */
+Result timer_insert(const Config& config, Timer::Backend backend) {
+    const size_t batch = 10000;
+    const size_t rounds = 10 * config.scale;
+
+    Timer timer(backend);
+    Queue queue("bench_timer_insert", Queue::Type::Concurrent, ThreadPool::QoS::Utility);
+    Result result{std::string("timer_insert/") + backend_name(backend), {}};
+    std::vector<Timer::Handle> handles;
+    handles.reserve(batch);
+
+    for (size_t round = 0; round < rounds; round++) {
+        auto when = Clock::now() + std::chrono::hours(1);
+        auto start = Clock::now();
+        for (size_t i = 0; i < batch; i++) {
+            handles.push_back(timer.schedule([] {}, when + std::chrono::milliseconds(i), queue));
+        }
+        result.samples.push_back(elapsed_ns(start, Clock::now()) / static_cast<double>(batch));
+
+        for (auto& handle : handles) {
+            handle.cancel();
+        }
+        handles.clear();
+    }
+    return result;
+}
+
+/**
+ * @brief Firing rate of many timers due at the same time.
+ *
+ * One sample per round: time from the deadline to the last task, divided
+ * by the number of timers.
+ */
+Result timer_fire(const Config& config, Timer::Backend backend) {
+    const size_t batch = 10000;
+    const size_t rounds = 10 * config.scale;
+
+    Timer timer(backend);
+    Queue queue("bench_timer_fire", Queue::Type::Concurrent, ThreadPool::QoS::UserInitiated);
+    Result result{std::string("timer_fire/") + backend_name(backend), {}};
+
+    for (size_t round = 0; round < rounds; round++) {
+        std::atomic<size_t> fired{0};
+        auto when = Clock::now() + std::chrono::milliseconds(20);
+        for (size_t i = 0; i < batch; i++) {
+            timer.schedule([&] { fired.fetch_add(1, std::memory_order_relaxed); }, when, queue);
+        }
+        while (fired.load(std::memory_order_acquire) != batch) {
+            std::this_thread::yield();
+        }
+        result.samples.push_back(elapsed_ns(when, Clock::now()) / static_cast<double>(batch));
+    }
+    return result;
+}
+
+/**
+ * @brief Lateness of single timers: actual start minus requested time.
+ */
+Result timer_jitter(const Config& config, Timer::Backend backend) {
+    const size_t iterations = 200 * config.scale;
+
+    Timer timer(backend);
+    Queue queue("bench_timer_jitter", Queue::Type::Serial, ThreadPool::QoS::UserInteractive);
+    Result result{std::string("timer_jitter/") + backend_name(backend), {}};
+    result.samples.reserve(iterations);
+
+    for (size_t i = 0; i < iterations; i++) {
+        std::atomic<bool> fired{false};
+        auto when = Clock::now() + std::chrono::microseconds(2000 + 37 * (i % 50));
+        timer.schedule([&] {
+            result.samples.push_back(elapsed_ns(when, Clock::now()));
+            fired.store(true, std::memory_order_release);
+        }, when, queue);
+        while (!fired.load(std::memory_order_acquire)) {
+            std::this_thread::yield();
+        }
+    }
+    return result;
+}
+
+/**
+ * @brief Enqueue-to-start latency of UserInteractive tasks under a Background flood.
+ */
+Result mixed_qos_tail(const Config& config) {
+    const size_t probes = 2000 * config.scale;
+    const size_t threads = std::max<size_t>(2, std::thread::hardware_concurrency());
+
+    ThreadPool pool(threads);
+    Result result{"mixed_qos_tail/user_interactive", {}};
+    result.samples.reserve(probes);
+
+    std::atomic<bool> stop{false};
+    std::atomic<size_t> flood{0};
+    auto busy = [] {
+        auto until = Clock::now() + std::chrono::microseconds(50);
+        while (Clock::now() < until) {}
+    };
+
+    std::thread producer([&] {
+        while (!stop.load(std::memory_order_relaxed)) {
+            if (flood.load(std::memory_order_relaxed) < threads * 8) {
+                flood.fetch_add(1, std::memory_order_relaxed);
+                pool.submit([&] { busy(); flood.fetch_sub(1, std::memory_order_relaxed); },
+                            ThreadPool::QoS::Background);
+            } else {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    std::mutex mutex;
+    for (size_t i = 0; i < probes; i++) {
+        std::atomic<bool> started{false};
+        auto submitted = Clock::now();
+        pool.submit([&] {
+            double latency = elapsed_ns(submitted, Clock::now());
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                result.samples.push_back(latency);
+            }
+            started.store(true, std::memory_order_release);
+        }, ThreadPool::QoS::UserInteractive);
+        while (!started.load(std::memory_order_acquire)) {
+            std::this_thread::yield();
+        }
+    }
+
+    stop = true;
+    producer.join();
+    while (flood.load() != 0) {
+        std::this_thread::yield();
+    }
+    return result;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Config config;
+    for (int i = 1; i < argc; i++) {
+        if (std::strcmp(argv[i], "--format=csv") == 0) {
+            config.csv = true;
+        } else if (std::strcmp(argv[i], "--format=json") == 0) {
+            config.csv = false;
+        } else if (std::strncmp(argv[i], "--filter=", 9) == 0) {
+            config.filter = argv[i] + 9;
+        } else if (std::strncmp(argv[i], "--scale=", 8) == 0) {
+            config.scale = std::max<size_t>(1, std::strtoul(argv[i] + 8, nullptr, 10));
+        } else {
+            std::fprintf(stderr, "usage: %s [--format=json|csv] [--filter=substring] [--scale=N]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    std::vector<std::pair<std::string, std::function<Result()>>> benchmarks;
+
+    std::vector<size_t> thread_counts{1, 2, 4};
+    size_t hardware = std::thread::hardware_concurrency();
+    if (hardware > 4)
+        thread_counts.push_back(hardware);
+    for (size_t threads : thread_counts) {
+        benchmarks.emplace_back("submit_throughput/threads:" + std::to_string(threads),
+                                [&config, threads] { return submit_throughput(config, threads); });
+    }
+    benchmarks.emplace_back("wake_latency/park", [&] { return wake_latency(config, 0); });
+    benchmarks.emplace_back("wake_latency/spin", [&] { return wake_latency(config, ThreadPool::Options{}.spin_count); });
+    benchmarks.emplace_back("serial_ping_pong", [&] { return serial_ping_pong(config); });
+    benchmarks.emplace_back("sync_round_trip/serial", [&] { return sync_round_trip(config, Queue::Type::Serial); });
+    benchmarks.emplace_back("sync_round_trip/concurrent", [&] { return sync_round_trip(config, Queue::Type::Concurrent); });
+    for (auto backend : {Timer::Backend::Heap, Timer::Backend::Wheel}) {
+        std::string suffix = backend_name(backend);
+        benchmarks.emplace_back("timer_insert/" + suffix, [&config, backend] { return timer_insert(config, backend); });
+        benchmarks.emplace_back("timer_fire/" + suffix, [&config, backend] { return timer_fire(config, backend); });
+        benchmarks.emplace_back("timer_jitter/" + suffix, [&config, backend] { return timer_jitter(config, backend); });
+    }
+    benchmarks.emplace_back("mixed_qos_tail/user_interactive", [&] { return mixed_qos_tail(config); });
+
+    bool first = true;
+    for (auto& [name, run] : benchmarks) {
+        if (!config.filter.empty() && name.find(config.filter) == std::string::npos)
+            continue;
+        report(config, run(), first);
+    }
+    if (!config.csv)
+        std::printf(first ? "[]\n" : "\n]\n");
+    return 0;
+}
@@ -0,0 +1,200 @@
+/*
+ * Copyright 2025 Denis Silko
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#if !defined(__cpp_impl_coroutine)
+#error "TurboQ/coroutine.hpp requires C++20 coroutines (configure with -DBUILD_COROUTINES=ON)"
+#endif
+
+#include <TurboQ/future.hpp>
+#include <TurboQ/queue.hpp>
+
+#include <coroutine>
+#include <exception>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+namespace turboq {
+
+template <typename T = void>
+class task;
+
+namespace detail {
+
+template <typename T>
+class TaskPromiseBase {
+public:
+    void return_value(T value) { value_.emplace(std::move(value)); }
+
+    T result() {
+        if (exception_)
+            std::rethrow_exception(exception_);
+        return std::move(*value_);
+    }
+
+protected:
+    std::optional<T> value_;
+    std::exception_ptr exception_;
+};
+
+template <>
+class TaskPromiseBase<void> {
+public:
+    void return_void() {}
+
+    void result() {
+        if (exception_)
+            std::rethrow_exception(exception_);
+    }
+
+protected:
+    std::exception_ptr exception_;
+};
+
+/**
+ * @brief Fire-and-forget coroutine used to drive a task from non-coroutine code.
+ *
+ * Starts eagerly and destroys its own frame when it finishes.
+ */
+struct Detached {
+    struct promise_type {
+        Detached get_return_object() noexcept { return {}; }
+        std::suspend_never initial_suspend() noexcept { return {}; }
+        std::suspend_never final_suspend() noexcept { return {}; }
+        void return_void() noexcept {}
+        void unhandled_exception() noexcept { std::terminate(); }
+    };
+};
+
+template <typename T>
+Detached drive(task<T> work, std::shared_ptr<FutureState<T>> state, Queue* queue) {
+    if (queue)
+        co_await queue->schedule();
+    try {
+        if constexpr (std::is_void<T>::value) {
+            co_await std::move(work);
+            state->set_value();
+        } else {
+            state->set_value(co_await std::move(work));
+        }
+    } catch (...) {
+        state->set_exception(std::current_exception());
+    }
+}
+
+} // namespace detail
+
+/**
+ * @brief Lazily started coroutine that produces a value of type T.
+ *
+ * A task runs when it is awaited and resumes its awaiter directly through
+ * symmetric transfer, so chains of tasks neither hop threads nor allocate
+ * beyond their coroutine frames. Combine with Queue::schedule() and
+ * Queue::after() to move between queues; use spawn() or sync_wait() to start
+ * a task from regular code.
+ *
+ * @tparam T Result type, may be void.
+ */
+template <typename T>
+class task {
+public:
+    struct promise_type : detail::TaskPromiseBase<T> {
+        std::coroutine_handle<> continuation = std::noop_coroutine();
+
+        task get_return_object() noexcept {
+            return task(std::coroutine_handle<promise_type>::from_promise(*this));
+        }
+
+        std::suspend_always initial_suspend() noexcept { return {}; }
+
+        auto final_suspend() noexcept {
+            struct FinalAwaiter {
+                bool await_ready() const noexcept { return false; }
+                std::coroutine_handle<> await_suspend(std::coroutine_handle<promise_type> handle) noexcept {
+                    return handle.promise().continuation;
+                }
+                void await_resume() const noexcept {}
+            };
+            return FinalAwaiter{};
+        }
+
+        void unhandled_exception() noexcept { this->exception_ = std::current_exception(); }
+    };
+
+    task(task&& other) noexcept : handle_(std::exchange(other.handle_, nullptr)) {}
+
+    task& operator=(task&& other) noexcept {
+        if (this != &other) {
+            if (handle_)
+                handle_.destroy();
+            handle_ = std::exchange(other.handle_, nullptr);
+        }
+        return *this;
+    }
+
+    task(const task&) = delete;
+    task& operator=(const task&) = delete;
+
+    ~task() {
+        if (handle_)
+            handle_.destroy();
+    }
+
+    bool await_ready() const noexcept { return false; }
+
+    std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting) noexcept {
+        handle_.promise().continuation = awaiting;
+        return handle_;
+    }
+
+    T await_resume() { return handle_.promise().result(); }
+
+private:
+    explicit task(std::coroutine_handle<promise_type> handle) : handle_(handle) {}
+
+    std::coroutine_handle<promise_type> handle_;
+};
+
+/**
+ * @brief Starts @p work on @p queue and returns a Future for its result.
+ *
+ * @param queue Queue the task starts on.
+ * @param work Task to run.
+ * @return Future that becomes ready when the task finishes.
+ */
+template <typename T>
+Future<T> spawn(Queue& queue, task<T> work) {
+    auto [state, future] = detail::FutureAccess::make<T>();
+    detail::drive(std::move(work), std::move(state), &queue);
+    return std::move(future);
+}
+
+/**
+ * @brief Runs @p work starting on the calling thread and blocks until it finishes.
+ *
+ * @param work Task to run.
+ * @return The task's result; exceptions are rethrown.
+ */
+template <typename T>
+T sync_wait(task<T> work) {
+    auto [state, future] = detail::FutureAccess::make<T>();
+    detail::drive(std::move(work), std::move(state), nullptr);
+    return future.get();
+}
+
+} // namespace turboq
@@ -0,0 +1,155 @@
+/*
+ * Copyright 2025 Denis Silko
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#endif
+
+namespace turboq {
+namespace detail {
+
+/**
+ * @brief Hints the CPU that the caller is busy-waiting.
+ */
+inline void cpu_relax() {
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+    _mm_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+    asm volatile("yield");
+#endif
+}
+
+/**
+ * @brief Event count: lets threads sleep on a condition without a lost wakeup.
+ *
+ * A waiter calls prepare_wait(), re-checks its condition, then either
+ * cancel_wait() or wait(). A notifier changes the condition first and then
+ * calls notify(), which returns without any locking or syscall while nobody
+ * is registered as a waiter.
+ *
+ * The low half of the state word counts waiters, the high half is an epoch
+ * bumped by every notification.
+ */
+class EventCount {
+public:
+    using Key = uint32_t;
+
+    EventCount() = default;
+    EventCount(const EventCount&) = delete;
+    EventCount& operator=(const EventCount&) = delete;
+
+    /**
+     * @brief Registers the caller as a waiter and returns the current epoch.
+     */
+    Key prepare_wait() {
+        return epoch(state_.fetch_add(kWaiter, std::memory_order_seq_cst));
+    }
+
+    /**
+     * @brief Withdraws a registration made by prepare_wait().
+     */
+    void cancel_wait() {
+        state_.fetch_sub(kWaiter, std::memory_order_seq_cst);
+    }
+
+    /**
+     * @brief Blocks until a notification newer than @p key arrives.
+     */
+    void wait(Key key) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        cv_.wait(lock, [&] { return epoch(state_.load(std::memory_order_acquire)) != key; });
+        state_.fetch_sub(kWaiter, std::memory_order_seq_cst);
+    }
+
+    /**
+     * @brief Like wait(), but gives up at @p deadline.
+     *
+     * @return false on timeout.
+     */
+    template <typename Clock, typename Duration>
+    bool wait_until(Key key, const std::chrono::time_point<Clock, Duration>& deadline) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        bool notified = cv_.wait_until(lock, deadline, [&] {
+            return epoch(state_.load(std::memory_order_acquire)) != key;
+        });
+        state_.fetch_sub(kWaiter, std::memory_order_seq_cst);
+        return notified;
+    }
+
+    /**
+     * @brief Wakes up to @p count waiters.
+     */
+    void notify(size_t count) {
+        uint64_t state = state_.load(std::memory_order_seq_cst);
+        if (waiters(state) == 0)
+            return;
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            state = state_.fetch_add(kEpoch, std::memory_order_seq_cst);
+        }
+        if (count >= waiters(state)) {
+            cv_.notify_all();
+        } else {
+            for (size_t i = 0; i < count; i++) {
+                cv_.notify_one();
+            }
+        }
+    }
+
+    /**
+     * @brief Wakes every waiter.
+     */
+    void notify_all() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            state_.fetch_add(kEpoch, std::memory_order_seq_cst);
+        }
+        cv_.notify_all();
+    }
+
+    /**
+     * @brief Returns the number of registered waiters.
+     */
+    size_t waiters() const {
+        return waiters(state_.load(std::memory_order_seq_cst));
+    }
+
+private:
+    static constexpr uint64_t kWaiter = 1;
+    static constexpr uint64_t kEpoch = uint64_t(1) << 32;
+
+    static Key epoch(uint64_t state) { return static_cast<Key>(state >> 32); }
+    static size_t waiters(uint64_t state) { return static_cast<size_t>(state & (kEpoch - 1)); }
+
+    std::atomic<uint64_t> state_{0};
+    std::mutex mutex_;
+    std::condition_variable cv_;
+};
+
+} // namespace detail
+} // namespace turboq
@@ -0,0 +1,172 @@
+/*
+ * Copyright 2025 Denis Silko
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace turboq {
+namespace detail {
+
+/**
+ * @brief Number of log2 buckets in a latency histogram.
+ *
+ * Bucket i counts durations in [2^(i-1), 2^i) nanoseconds; the last bucket
+ * also takes everything above about two seconds.
+ */
+constexpr size_t kHistogramBuckets = 32;
+
+inline size_t histogram_bucket(uint64_t nanoseconds) {
+#if defined(__GNUC__) || defined(__clang__)
+    size_t bucket = nanoseconds ? 64 - __builtin_clzll(nanoseconds) : 0;
+#else
+    size_t bucket = 0;
+    while (nanoseconds) {
+        nanoseconds >>= 1;
+        bucket++;
+    }
+#endif
+    return bucket < kHistogramBuckets ? bucket : kHistogramBuckets - 1;
+}
+
+/**
+ * @brief Adds to a counter that only the calling thread writes.
+ *
+ * A plain load and store instead of a locked read-modify-write; readers
+ * may see a slightly stale value but never a torn one.
+ */
+inline void bump(std::atomic<uint64_t>& counter, uint64_t value = 1) {
+    counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+}
+
+/**
+ * @brief One in this many tasks is timed when metrics are enabled.
+ *
+ * Reading the clock three times per task costs more than the task itself
+ * for small tasks; sampling keeps the histograms accurate at a fraction of that.
+ */
+constexpr uint32_t kSampleInterval = 32;
+
+inline thread_local uint32_t sample_tick = 0;
+
+inline bool sample() {
+    return (++sample_tick & (kSampleInterval - 1)) == 0;
+}
+
+inline uint64_t now_ns() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+/**
+ * @brief Number of cache-line shards in each QueueCounters.
+ */
+constexpr size_t kCounterShards = 16;
+
+/**
+ * @brief Returns the counter shard of the calling thread.
+ *
+ * Threads take shards round robin on first use, so with no more threads
+ * than shards every shard has a single writer and stays in its cache.
+ */
+inline size_t counter_shard() {
+    static std::atomic<size_t> next{0};
+    static thread_local size_t shard = next.fetch_add(1, std::memory_order_relaxed) % kCounterShards;
+    return shard;
+}
+
+/**
+ * @brief Throughput counters of one Queue, listed for ThreadPool::stats().
+ *
+ * Queues register themselves on construction and unregister on destruction.
+ * The queue updates them itself, before it may be destroyed. Updates go to
+ * the calling thread's shard; readers add the shards up.
+ */
+struct QueueCounters {
+    struct alignas(64) Shard {
+        std::atomic<uint64_t> tasks{0};
+        std::atomic<uint64_t> busy_ns{0};
+    };
+
+    explicit QueueCounters(std::string name);
+    ~QueueCounters();
+
+    QueueCounters(const QueueCounters&) = delete;
+    QueueCounters& operator=(const QueueCounters&) = delete;
+
+    uint64_t tasks() const {
+        uint64_t total = 0;
+        for (const auto& shard : shards) {
+            total += shard.tasks.load(std::memory_order_relaxed);
+        }
+        return total;
+    }
+
+    uint64_t busy_ns() const {
+        uint64_t total = 0;
+        for (const auto& shard : shards) {
+            total += shard.busy_ns.load(std::memory_order_relaxed);
+        }
+        return total;
+    }
+
+    const std::string name;
+    Shard shards[kCounterShards];
+
+    QueueCounters* prev = nullptr;
+    QueueCounters* next = nullptr;
+};
+
+/**
+ * @brief Marks a pool task that is counted but not timed.
+ */
+constexpr uint64_t kUntimed = 1;
+
+/**
+ * @brief Start time of the pool task running on this thread, in nanoseconds.
+ *
+ * Set by ThreadPool around each task: 0 with metrics disabled, kUntimed for
+ * tasks outside the sample, the start time otherwise. Lets a Queue charge
+ * itself without a second clock read at the start.
+ */
+inline thread_local uint64_t task_start_ns = 0;
+
+/**
+ * @brief Charges @p tasks and the time since @p since to @p queue.
+ *
+ * Busy time is only measured for sampled tasks and scaled by kSampleInterval.
+ *
+ * @param since Start of the measured span; defaults to the start of the current pool task.
+ * @return End of the measured span, or @p since if it is not timed.
+ */
+inline uint64_t record(QueueCounters& queue, uint64_t tasks, uint64_t since = task_start_ns) {
+    if (since == 0)
+        return 0;
+    auto& shard = queue.shards[counter_shard()];
+    shard.tasks.fetch_add(tasks, std::memory_order_relaxed);
+    if (since == kUntimed)
+        return kUntimed;
+    uint64_t now = now_ns();
+    shard.busy_ns.fetch_add((now - since) * kSampleInterval, std::memory_order_relaxed);
+    return now;
+}
+
+} // namespace detail
+} // namespace turboq
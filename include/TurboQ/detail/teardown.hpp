@@ -0,0 +1,91 @@
+/*
+ * Copyright 2025 Denis Silko
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <utility>
+
+namespace turboq {
+namespace detail {
+
+/**
+ * @brief Process-wide signal for destructors that wait for work still using their object.
+ *
+ * It is never destroyed, so that work may notify it after its last access
+ * to an object whose destructor may already have returned. Notifying costs
+ * a single load while nothing is being destroyed.
+ */
+class Teardown {
+public:
+    static Teardown& instance() {
+        static Teardown* teardown = new Teardown;
+        return *teardown;
+    }
+
+    /**
+     * @brief Wakes every waiter; call after the store that may satisfy one.
+     */
+    void notify() {
+        if (waiters_.load(std::memory_order_seq_cst) == 0)
+            return;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+        }
+        cv_.notify_all();
+    }
+
+    /**
+     * @brief Blocks until @p done returns true, re-checking it on every notify().
+     */
+    template <typename Condition>
+    void wait(Condition done) {
+        if (done())
+            return;
+        std::unique_lock<std::mutex> lock(mutex_);
+        waiters_.fetch_add(1, std::memory_order_seq_cst);
+        cv_.wait(lock, done);
+        waiters_.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+private:
+    Teardown() = default;
+
+    std::atomic<size_t> waiters_{0};
+    std::mutex mutex_;
+    std::condition_variable cv_;
+};
+
+/**
+ * @brief Wakes destructors waiting in wait_for_teardown().
+ */
+inline void notify_teardown() {
+    Teardown::instance().notify();
+}
+
+/**
+ * @brief Blocks until @p done returns true.
+ */
+template <typename Condition>
+void wait_for_teardown(Condition done) {
+    Teardown::instance().wait(std::move(done));
+}
+
+} // namespace detail
+} // namespace turboq
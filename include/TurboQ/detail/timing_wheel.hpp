@@ -0,0 +1,223 @@
+/*
+ * Copyright 2025 Denis Silko
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace turboq {
+namespace detail {
+
+/**
+ * @brief Hierarchical timing wheel keyed by integer ticks.
+ *
+ * Each level has 64 slots and a slot on level N spans 64^N ticks, so six
+ * levels cover about 2^36 ticks (over two years at millisecond resolution). Insertion is O(1), finding the next expiration is O(levels)
+ * thanks to a per-level occupancy bitmap, and an entry is moved down at most
+ * once per level before it expires.
+ *
+ * @tparam T Payload type, must be movable.
+ */
+template <typename T>
+class TimingWheel {
+public:
+    static constexpr size_t kLevels = 6;
+    static constexpr size_t kSlotBits = 6;
+    static constexpr size_t kSlots = size_t{1} << kSlotBits;
+
+    /**
+     * @brief Adds @p value to expire at @p tick.
+     *
+     * Ticks in the past expire on the next call to advance(). Ticks beyond the
+     * range of the top level are parked in its last slot and re-sorted when
+     * that slot is reached.
+     */
+    void insert(uint64_t tick, T value) {
+        if (tick < elapsed_)
+            tick = elapsed_;
+
+        uint64_t placement = tick - elapsed_ > kMaxSpan ? elapsed_ + kMaxSpan : tick;
+        size_t level = level_for(placement);
+        size_t slot = slot_for(placement, level);
+        levels_[level].slots[slot].push_back(Entry{tick, std::move(value)});
+        levels_[level].occupied |= uint64_t{1} << slot;
+        size_++;
+    }
+
+    /**
+     * @brief Returns the tick at which advance() has work to do next.
+     *
+     * This is either an expiration or the start of a slot that has to be
+     * cascaded to a lower level; it is never later than the earliest deadline.
+     */
+    std::optional<uint64_t> next_expiration() const {
+        if (auto next = find_next())
+            return next->tick;
+        return std::nullopt;
+    }
+
+    /**
+     * @brief Moves time forward to @p now and hands every expired entry to @p on_expired.
+     */
+    template <typename F>
+    void advance(uint64_t now, F&& on_expired) {
+        while (true) {
+            auto next = find_next();
+            if (!next || next->tick > now)
+                break;
+
+            elapsed_ = next->tick;
+            scratch_.swap(levels_[next->level].slots[next->slot]);
+            levels_[next->level].occupied &= ~(uint64_t{1} << next->slot);
+            size_ -= scratch_.size();
+
+            for (auto& entry : scratch_) {
+                if (entry.tick <= elapsed_) {
+                    on_expired(std::move(entry.value));
+                } else {
+                    insert(entry.tick, std::move(entry.value));
+                }
+            }
+            scratch_.clear();
+        }
+
+        if (now > elapsed_)
+            elapsed_ = now;
+    }
+
+    /**
+     * @brief Removes every entry whose payload satisfies @p pred. O(size).
+     *
+     * @return Number of entries removed.
+     */
+    template <typename P>
+    size_t remove_if(P&& pred) {
+        size_t removed = 0;
+        for (auto& level : levels_) {
+            for (size_t slot = 0; slot < kSlots; slot++) {
+                auto& entries = level.slots[slot];
+                auto end = std::remove_if(entries.begin(), entries.end(),
+                                          [&](const Entry& entry) { return pred(entry.value); });
+                removed += static_cast<size_t>(entries.end() - end);
+                entries.erase(end, entries.end());
+                if (entries.empty())
+                    level.occupied &= ~(uint64_t{1} << slot);
+            }
+        }
+        size_ -= removed;
+        return removed;
+    }
+
+    bool empty() const { return size_ == 0; }
+    size_t size() const { return size_; }
+    uint64_t elapsed() const { return elapsed_; }
+
+private:
+    static constexpr uint64_t kTopSlotRange = uint64_t{1} << ((kLevels - 1) * kSlotBits);
+    static constexpr uint64_t kMaxSpan = kTopSlotRange * (kSlots - 1) - 1;
+
+    struct Entry {
+        uint64_t tick;
+        T value;
+    };
+
+    struct Level {
+        std::array<std::vector<Entry>, kSlots> slots;
+        uint64_t occupied = 0;
+    };
+
+    struct Expiration {
+        uint64_t tick;
+        size_t level;
+        size_t slot;
+    };
+
+    // Entries on a lower level always expire before entries on a higher one,
+    // so the first occupied level holds the next expiration.
+    std::optional<Expiration> find_next() const {
+        for (size_t level = 0; level < kLevels; level++) {
+            uint64_t occupied = levels_[level].occupied;
+            if (occupied == 0)
+                continue;
+
+            size_t now_slot = slot_for(elapsed_, level);
+            size_t slot = (count_trailing_zeros(rotate_right(occupied, now_slot)) + now_slot) % kSlots;
+
+            uint64_t slot_range = uint64_t{1} << (level * kSlotBits);
+            uint64_t level_range = slot_range << kSlotBits;
+            uint64_t tick = (elapsed_ & ~(level_range - 1)) + slot * slot_range;
+
+            // Only the top level wraps around: a slot behind the cursor is one rotation ahead.
+            if (tick < elapsed_)
+                tick += level_range;
+            return Expiration{tick, level, slot};
+        }
+        return std::nullopt;
+    }
+
+    size_t level_for(uint64_t tick) const {
+        uint64_t masked = (elapsed_ ^ tick) | (kSlots - 1);
+        size_t level = (63 - count_leading_zeros(masked)) / kSlotBits;
+        return level < kLevels ? level : kLevels - 1;
+    }
+
+    static size_t slot_for(uint64_t tick, size_t level) {
+        return static_cast<size_t>((tick >> (level * kSlotBits)) & (kSlots - 1));
+    }
+
+    static uint64_t rotate_right(uint64_t value, size_t shift) {
+        return shift == 0 ? value : (value >> shift) | (value << (64 - shift));
+    }
+
+    static size_t count_trailing_zeros(uint64_t value) {
+#if defined(__GNUC__) || defined(__clang__)
+        return static_cast<size_t>(__builtin_ctzll(value));
+#else
+        size_t count = 0;
+        while ((value & 1) == 0) {
+            value >>= 1;
+            count++;
+        }
+        return count;
+#endif
+    }
+
+    static size_t count_leading_zeros(uint64_t value) {
+#if defined(__GNUC__) || defined(__clang__)
+        return static_cast<size_t>(__builtin_clzll(value));
+#else
+        size_t count = 0;
+        for (uint64_t bit = uint64_t{1} << 63; bit != 0 && (value & bit) == 0; bit >>= 1) {
+            count++;
+        }
+        return count;
+#endif
+    }
+
+    std::array<Level, kLevels> levels_;
+    std::vector<Entry> scratch_;
+    uint64_t elapsed_ = 0;
+    size_t size_ = 0;
+};
+
+} // namespace detail
+} // namespace turboq
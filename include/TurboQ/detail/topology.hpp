@@ -0,0 +1,69 @@
+/*
+ * Copyright 2025 Denis Silko
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+namespace turboq {
+namespace detail {
+
+/**
+ * @brief CPUs grouped by NUMA node.
+ *
+ * Only nodes that own at least one CPU usable by the process are listed.
+ */
+struct Topology {
+    std::vector<std::vector<int>> nodes;
+};
+
+/**
+ * @brief Parses a Linux CPU list such as "0-3,8,10-11".
+ *
+ * @return CPU ids in ascending order; malformed parts are skipped.
+ */
+std::vector<int> parse_cpu_list(const std::string& list);
+
+/**
+ * @brief Returns the CPUs the calling process may run on.
+ *
+ * Uses sched_getaffinity() on Linux; elsewhere 0 .. hardware_concurrency() - 1.
+ */
+std::vector<int> allowed_cpus();
+
+/**
+ * @brief Reads the NUMA layout from /sys/devices/system/node.
+ *
+ * Falls back to a single node holding all allowed CPUs when sysfs is
+ * unavailable.
+ */
+Topology detect_topology();
+
+/**
+ * @brief Restricts the calling thread to @p cpus.
+ *
+ * @return false if the platform does not support it or the call failed.
+ */
+bool pin_current_thread(const std::vector<int>& cpus);
+
+/**
+ * @brief Returns the CPU the calling thread is running on, or -1 if unknown.
+ */
+int current_cpu();
+
+} // namespace detail
+} // namespace turboq
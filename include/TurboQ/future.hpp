@@ -0,0 +1,323 @@
+/*
+ * Copyright 2025 Denis Silko
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <TurboQ/task.hpp>
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+namespace turboq {
+
+template <typename T>
+class Future;
+
+namespace detail {
+
+struct Unit {};
+
+/**
+ * @brief Shared state between a running task and its Future.
+ *
+ * Holds the result and at most one continuation. The only synchronization is
+ * an atomic state word: the producer publishes the result with one exchange,
+ * and a consumer that arrives first parks its continuation instead of blocking.
+ */
+template <typename T>
+class FutureState : public std::enable_shared_from_this<FutureState<T>> {
+public:
+    using Value = std::conditional_t<std::is_void<T>::value, Unit, T>;
+
+    template <typename... Args>
+    void set_value(Args&&... args) {
+        value_.emplace(std::forward<Args>(args)...);
+        publish();
+    }
+
+    void set_exception(std::exception_ptr exception) {
+        exception_ = std::move(exception);
+        publish();
+    }
+
+    bool ready() const {
+        return state_.load(std::memory_order_acquire) == kReady;
+    }
+
+    /**
+     * @brief Runs @p continuation once the result is available.
+     *
+     * If the result is already there the continuation runs on the calling
+     * thread, otherwise on the thread that publishes the result.
+     */
+    void on_ready(Task continuation) {
+        continuation_ = std::move(continuation);
+        uint8_t expected = kEmpty;
+        if (!state_.compare_exchange_strong(expected, kWaiting, std::memory_order_acq_rel)) {
+            Task now = std::move(continuation_);
+            now();
+        }
+    }
+
+    bool has_exception() const { return exception_ != nullptr; }
+    std::exception_ptr exception() const { return exception_; }
+
+    /**
+     * @brief Moves the result out, rethrowing a stored exception.
+     */
+    T take() {
+        if (exception_)
+            std::rethrow_exception(exception_);
+        if constexpr (!std::is_void<T>::value)
+            return std::move(*value_);
+    }
+
+private:
+    static constexpr uint8_t kEmpty = 0;
+    static constexpr uint8_t kWaiting = 1;
+    static constexpr uint8_t kReady = 2;
+
+    void publish() {
+        if (state_.exchange(kReady, std::memory_order_acq_rel) == kWaiting) {
+            Task continuation = std::move(continuation_);
+            continuation();
+        }
+    }
+
+    std::atomic<uint8_t> state_{kEmpty};
+    std::optional<Value> value_;
+    std::exception_ptr exception_;
+    Task continuation_;
+};
+
+/**
+ * @brief Invokes @p f with @p args and stores the outcome in @p state.
+ */
+template <typename T, typename F, typename... Args>
+void fulfill(FutureState<T>& state, F& f, Args&&... args) {
+    try {
+        if constexpr (std::is_void<T>::value) {
+            std::invoke(f, std::forward<Args>(args)...);
+            state.set_value();
+        } else {
+            state.set_value(std::invoke(f, std::forward<Args>(args)...));
+        }
+    } catch (...) {
+        state.set_exception(std::current_exception());
+    }
+}
+
+template <typename T, typename F>
+struct ThenResult {
+    using type = std::invoke_result_t<F&, T>;
+};
+
+template <typename F>
+struct ThenResult<void, F> {
+    using type = std::invoke_result_t<F&>;
+};
+
+/**
+ * @brief Submits a continuation to an executor; Queue bypasses its capacity.
+ */
+template <typename Executor>
+struct Continuation {
+    template <typename F>
+    static void post(Executor& executor, F&& f) { executor.async(std::forward<F>(f)); }
+};
+
+/**
+ * @brief Callable that runs @p F once and stores its outcome in a FutureState.
+ *
+ * If it is destroyed without having run, for instance because a bounded
+ * queue dropped it, the state receives std::future_error with
+ * std::future_errc::broken_promise so that waiters and continuations are
+ * not left hanging.
+ */
+template <typename R, typename F>
+class Packaged {
+public:
+    template <typename G>
+    Packaged(std::shared_ptr<FutureState<R>> state, G&& f)
+        : state_(std::move(state)), f_(std::forward<G>(f)) {}
+
+    Packaged(Packaged&&) = default;
+    Packaged& operator=(Packaged&&) = delete;
+    Packaged(const Packaged&) = delete;
+    Packaged& operator=(const Packaged&) = delete;
+
+    ~Packaged() {
+        if (state_)
+            state_->set_exception(std::make_exception_ptr(std::future_error(std::future_errc::broken_promise)));
+    }
+
+    void operator()() {
+        auto state = std::move(state_);
+        fulfill(*state, f_);
+    }
+
+private:
+    std::shared_ptr<FutureState<R>> state_;
+    F f_;
+};
+
+/**
+ * @brief Creates Futures together with the state or task that fulfils them.
+ */
+struct FutureAccess {
+    template <typename T>
+    static auto make() {
+        auto state = std::make_shared<FutureState<T>>();
+        Future<T> future(state);
+        return std::make_pair(std::move(state), std::move(future));
+    }
+
+    template <typename F>
+    static auto package(F&& f) {
+        using R = std::invoke_result_t<std::decay_t<F>&>;
+        auto state = std::make_shared<FutureState<R>>();
+        Future<R> future(state);
+        Packaged<R, std::decay_t<F>> task(std::move(state), std::forward<F>(f));
+        return std::make_pair(std::move(task), std::move(future));
+    }
+};
+
+} // namespace detail
+
+/**
+ * @brief Result of a task started with Queue::async_result() or ThreadPool::submit_result().
+ *
+ * A Future is single-consumer and move-only: call exactly one of get() or
+ * then(). The shared state is a single allocation; a mutex and condition
+ * variable only come into play on the stack of a thread that blocks in wait().
+ *
+ * @tparam T Result type, may be void.
+ */
+template <typename T>
+class Future {
+public:
+    Future() = default;
+
+    Future(Future&&) noexcept = default;
+    Future& operator=(Future&&) noexcept = default;
+    Future(const Future&) = delete;
+    Future& operator=(const Future&) = delete;
+
+    /**
+     * @brief Returns true if the future refers to a result that was not consumed yet.
+     */
+    bool valid() const { return state_ != nullptr; }
+
+    /**
+     * @brief Returns true once the result or an exception is available.
+     */
+    bool ready() const { return state_ && state_->ready(); }
+
+    /**
+     * @brief Blocks the calling thread until the result is available.
+     */
+    void wait() {
+        if (state_->ready())
+            return;
+
+        std::mutex mutex;
+        std::condition_variable cv;
+        bool done = false;
+
+        state_->on_ready([&] {
+            // Notify under the lock so the waiter cannot return before we are done.
+            std::lock_guard<std::mutex> lock(mutex);
+            done = true;
+            cv.notify_one();
+        });
+
+        std::unique_lock<std::mutex> lock(mutex);
+        cv.wait(lock, [&] { return done; });
+    }
+
+    /**
+     * @brief Waits for and returns the result, rethrowing a stored exception.
+     *
+     * Consumes the future.
+     */
+    T get() {
+        wait();
+        auto state = std::move(state_);
+        return state->take();
+    }
+
+    /**
+     * @brief Attaches a continuation that runs on @p queue once the result is available.
+     *
+     * The continuation receives the result (nothing for Future<void>) and is
+     * submitted with queue.async(); no thread waits for the result. On a
+     * Queue it is not subject to the queue's capacity. If this future holds
+     * an exception, the continuation is skipped and the exception is
+     * forwarded to the returned future. Consumes the future.
+     *
+     * @param queue Queue (or any type with async(Task)) that runs the continuation.
+     * @param f Continuation.
+     * @return Future of the continuation's result.
+     */
+    template <typename Executor, typename F>
+    auto then(Executor& queue, F&& f) -> Future<typename detail::ThenResult<T, std::decay_t<F>>::type> {
+        using R = typename detail::ThenResult<T, std::decay_t<F>>::type;
+
+        auto next = std::make_shared<detail::FutureState<R>>();
+        Future<R> result(next);
+
+        // Keep the state alive in case the continuation runs right here.
+        auto keep = std::move(state_);
+        auto* state = keep.get();
+
+        // The continuation lives inside the state it observes, so it must not own it.
+        state->on_ready([state, &queue, next = std::move(next), f = std::forward<F>(f)]() mutable {
+            auto run = [source = state->shared_from_this(), next = std::move(next), f = std::move(f)]() mutable {
+                if (source->has_exception()) {
+                    next->set_exception(source->exception());
+                } else if constexpr (std::is_void<T>::value) {
+                    detail::fulfill(*next, f);
+                } else {
+                    detail::fulfill(*next, f, source->take());
+                }
+            };
+            detail::Continuation<Executor>::post(queue, std::move(run));
+        });
+
+        return result;
+    }
+
+private:
+    template <typename>
+    friend class Future;
+    friend struct detail::FutureAccess;
+
+    explicit Future(std::shared_ptr<detail::FutureState<T>> state)
+        : state_(std::move(state)) {}
+
+    std::shared_ptr<detail::FutureState<T>> state_;
+};
+
+} // namespace turboq
@@ -0,0 +1,93 @@
+/*
+ * Copyright 2025 Denis Silko
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <TurboQ/task.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace turboq {
+
+class Queue;
+
+/**
+ * @brief Tracks a set of tasks so that callers can wait for all of them.
+ *
+ * Every enter() must be balanced by a leave(); Queue::async(Group&, Task)
+ * does both around the submitted task. Entering and leaving only touch an
+ * atomic counter; the mutex is taken once when the count drops to zero and
+ * by callers that wait or register notifications.
+ *
+ * @note A Group must outlive the tasks that are part of it.
+ */
+class Group {
+public:
+    Group() = default;
+    ~Group() = default;
+
+    Group(const Group&) = delete;
+    Group& operator=(const Group&) = delete;
+
+    /**
+     * @brief Marks the start of a task that is part of the group.
+     */
+    void enter();
+
+    /**
+     * @brief Marks the end of a task previously registered with enter().
+     *
+     * When the last outstanding task leaves, blocked waiters are woken and
+     * pending notifications are submitted to their queues.
+     */
+    void leave();
+
+    /**
+     * @brief Blocks until every task in the group has left.
+     */
+    void wait();
+
+    /**
+     * @brief Blocks until every task in the group has left or @p timeout elapses.
+     *
+     * @param timeout Maximum time to wait.
+     * @return true if the group became empty, false on timeout.
+     */
+    bool wait(std::chrono::milliseconds timeout);
+
+    /**
+     * @brief Submits @p task to @p queue once every task in the group has left.
+     *
+     * If the group is already empty, the task is submitted immediately.
+     *
+     * @param queue Queue to run the task on; must outlive the notification.
+     * @param task The task to execute.
+     */
+    void notify(Queue& queue, Task task);
+
+private:
+    std::atomic<size_t> count_{0};
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    std::vector<std::pair<Queue*, Task>> notifications_;
+};
+
+} // namespace turboq
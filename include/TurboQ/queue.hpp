@@ -16,10 +16,11 @@
 
 #pragma once
 
+#include <TurboQ/task.hpp>
+#include <TurboQ/future.hpp>
 #include <TurboQ/thread_pool.hpp>
 #include <TurboQ/timer.hpp>
 
-#include <queue>
 #include <mutex>
 #include <string>
 #include <atomic>
@@ -27,9 +28,20 @@
 #include <chrono>
 #include <thread>
 #include <iostream>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <deque>
+#include <vector>
+
+#if defined(__cpp_impl_coroutine)
+#include <coroutine>
+#endif
 
 namespace turboq {
 
+class Group;
+
 /**
  * @brief Represents a task queue that can execute tasks serially or concurrently.
  *
@@ -41,7 +53,7 @@ namespace turboq {
  */
 class Queue {
 public:
-    using Task = std::function<void()>;
+    using Task = turboq::Task;
 
     /**
      * @brief Defines the type of execution for the queue.
@@ -51,6 +63,17 @@ public:
         Concurrent  ///< Tasks may be executed concurrently.
     };
 
+    /**
+     * @brief Limits how much backlog a serial queue drains per pool visit.
+     *
+     * A serial queue runs queued tasks back to back on the same worker until
+     * either limit is reached, then yields the worker and resubmits itself.
+     */
+    struct Quantum {
+        size_t max_tasks = 128;                    ///< Tasks per visit.
+        std::chrono::microseconds max_time{1000};  ///< Time per visit.
+    };
+
     /**
      * @brief Constructs a new Queue.
      *
@@ -62,9 +85,24 @@ public:
           Type type = Type::Serial,
           ThreadPool::QoS qos = ThreadPool::QoS::Utility);
 
+    /**
+     * @brief Destroys the queue.
+     *
+     * Blocks until tasks already submitted to the queue have run, so it
+     * must not be called from one of those tasks.
+     */
+    ~Queue();
+
+    Queue(const Queue&) = delete;
+    Queue& operator=(const Queue&) = delete;
+
     /**
      * @brief Returns a global shared queue with the specified QoS.
      *
+     * The global queues are concurrent and take no barriers: async_barrier()
+     * and sync_barrier() behave like async() and sync() on them, which keeps
+     * their tasks off the shared count that barriers need.
+     *
      * @param qos Quality of Service for the global queue. Default is Utility.
      * @return Reference to a global Queue instance.
      */
@@ -77,6 +115,90 @@ public:
      */
     void async(Task task);
 
+    /**
+     * @brief Submits a task for asynchronous execution as part of @p group.
+     *
+     * Enters the group before submitting and leaves it once the task has run,
+     * even if the task throws.
+     *
+     * @param group Group that tracks the task; must outlive it.
+     * @param task The task to execute.
+     */
+    void async(Group& group, Task task);
+
+    /**
+     * @brief Submits a task unless the queue is at its capacity.
+     *
+     * Never blocks and never discards other tasks, whatever the overflow
+     * policy passed to set_capacity() says.
+     *
+     * @param task The task to execute.
+     * @return False, counting the task as rejected, if the queue is full.
+     */
+    bool try_async(Task task);
+
+    /**
+     * @brief Submits a callable and returns a Future for its result.
+     *
+     * Exceptions thrown by @p f are stored in the Future and rethrown by Future::get().
+     * If the queue discards the task because it is full (see set_capacity()), the
+     * Future holds std::future_error with std::future_errc::broken_promise.
+     *
+     * @param f Callable taking no arguments.
+     * @return Future of the callable's result.
+     */
+    template <typename F>
+    auto async_result(F&& f) {
+        auto packaged = detail::FutureAccess::package(std::forward<F>(f));
+        async(std::move(packaged.first));
+        return std::move(packaged.second);
+    }
+
+    /**
+     * @brief Submits a batch of tasks for asynchronous execution.
+     *
+     * A serial queue links the batch in order and publishes it with a single
+     * atomic exchange; a concurrent queue forwards it to ThreadPool::submit_bulk()
+     * unless a barrier is pending. A queue with a capacity submits the
+     * tasks one by one with async().
+     * Elements are moved out of @p range.
+     *
+     * @param range Any iterable range of callables convertible to Task.
+     */
+    template <typename Range>
+    void async_batch(Range&& range) {
+        if (capacity_.load(std::memory_order_relaxed) > 0) {
+            for (auto&& task : range) {
+                async(Task(std::move(task)));
+            }
+            return;
+        }
+        enqueue_batch(std::forward<Range>(range));
+    }
+
+    /**
+     * @brief Submits a barrier task for asynchronous execution.
+     *
+     * On a concurrent queue the barrier waits for every task submitted before
+     * it to finish, then runs alone; tasks submitted after it start once it
+     * has returned. Ordinary tasks keep running in parallel with each other,
+     * so shared state written only by barriers can be read without locks.
+     * On a serial queue and on the global queues this is the same as async().
+     *
+     * @param task The task to execute.
+     */
+    void async_barrier(Task task);
+
+    /**
+     * @brief Executes a barrier task and waits for it to complete.
+     *
+     * Same ordering as async_barrier(). Must not be called from a task
+     * running on the same queue.
+     *
+     * @param task The task to execute.
+     */
+    void sync_barrier(Task task);
+
     /**
      * @brief Schedules a task to execute at a specific time point.
      *
@@ -86,8 +208,12 @@ public:
      *
      * @param when Time point when the task should run.
      * @param task The task to execute.
+     * @param leeway How much later than @p when the task may run, so that the
+     *        Timer can fire it together with nearby ones.
+     * @return Handle that can cancel or reschedule the task before it runs.
      */
-    void async_at(std::chrono::steady_clock::time_point when, Task task);
+    Timer::Handle async_at(std::chrono::steady_clock::time_point when, Task task,
+                           std::chrono::milliseconds leeway = std::chrono::milliseconds::zero());
 
     /**
      * @brief Schedules a task to execute after a specified delay.
@@ -98,8 +224,31 @@ public:
      *
      * @param delay Duration to wait before executing the task.
      * @param task The task to execute.
+     * @param leeway How much later than @p delay the task may run, so that the
+     *        Timer can fire it together with nearby ones.
+     * @return Handle that can cancel or reschedule the task before it runs.
      */
-    void async_after(std::chrono::milliseconds delay, Task task);
+    Timer::Handle async_after(std::chrono::milliseconds delay, Task task,
+                              std::chrono::milliseconds leeway = std::chrono::milliseconds::zero());
+
+    /**
+     * @brief Runs a task every @p period, starting one period from now.
+     *
+     * The schedule is drift-free and a tick does not allocate; see
+     * Timer::schedule_every() for details.
+     *
+     * @warning The queue object must outlive the series; cancel it through
+     * the handle before destroying the queue.
+     *
+     * @param period Interval between runs; must be positive.
+     * @param task The task to execute on every tick.
+     * @param missed What to do about ticks that could not run on time.
+     * @param leeway How much later than each tick the task may run.
+     * @return Handle that cancels the series.
+     */
+    Timer::Handle async_every(std::chrono::milliseconds period, Task task,
+                              Timer::Missed missed = Timer::Missed::Skip,
+                              std::chrono::milliseconds leeway = std::chrono::milliseconds::zero());
 
     /**
      * @brief Executes a task synchronously.
@@ -111,25 +260,342 @@ public:
      */
     void sync(Task task);
 
+    /**
+     * @brief Invokes @p fn for every index in [0, n) and waits for all of them.
+     *
+     * On a concurrent queue the indices are split into chunks that shrink as
+     * work runs out, so workers stay balanced on fine-grained loops. Up to
+     * one helper per pool worker joins in, the calling thread takes part as
+     * well, and completion costs a single wait. On a serial queue the indices
+     * run in order on the calling thread. Helpers are submitted like tasks
+     * and wait behind a pending barrier, but the calling thread does not, so
+     * barriers do not order against apply(). Helpers are not limited by
+     * set_capacity(). If @p fn throws, the rest of its chunk is skipped and
+     * the first exception is rethrown once all other chunks have finished.
+     *
+     * @param n Number of iterations.
+     * @param fn Callable invoked as fn(size_t index).
+     */
+    template <typename F>
+    void apply(size_t n, F&& fn) {
+        auto invoke = [](void* context, size_t begin, size_t end) {
+            auto& body = *static_cast<std::remove_reference_t<F>*>(context);
+            for (size_t i = begin; i < end; i++) {
+                body(i);
+            }
+        };
+        apply_range(n, invoke, const_cast<void*>(static_cast<const void*>(std::addressof(fn))));
+    }
+
+    /**
+     * @brief Invokes @p fn for every element of a random access range in parallel.
+     *
+     * Equivalent to apply() over the element indices.
+     *
+     * @param range Random access range; elements are passed by reference.
+     * @param fn Callable invoked as fn(element).
+     */
+    template <typename Range, typename F>
+    void parallel_for(Range&& range, F&& fn) {
+        using std::begin;
+        using std::end;
+        auto first = begin(range);
+        auto count = static_cast<size_t>(std::distance(first, end(range)));
+        apply(count, [&](size_t i) { fn(first[i]); });
+    }
+
+    /**
+     * @brief Sets the drain quantum of a serial queue.
+     *
+     * Larger values keep cache locality and cut per-task overhead; smaller
+     * values give other queues a turn sooner. Has no effect on concurrent queues.
+     *
+     * @param quantum Task count and time limits per pool visit.
+     */
+    void set_quantum(Quantum quantum);
+
+    /**
+     * @brief Bounds the number of tasks waiting in or running on the queue.
+     *
+     * Once @p capacity tasks submitted with async(), async_batch() or
+     * try_async() are outstanding, async() follows @p overflow: it waits for
+     * one of them to finish, discards the oldest one that has not started,
+     * or discards the new task. try_async() fails instead. Discarded and
+     * refused tasks are counted by rejected(); a discarded task is released,
+     * and its group left, right away.
+     *
+     * With Overflow::DropOldest the new task takes the turn of the task it
+     * replaces, so it may start before sync() work or a barrier submitted in
+     * between; if every outstanding task has already started, the new one
+     * is discarded. Barriers, sync(), work of queues targeting this one and
+     * runs submitted by Timer, Source, Reactor, Group::notify() and
+     * Future::then() are not limited.
+     *
+     * Call before submitting work. A capacity of 0 removes the limit.
+     *
+     * @param capacity Maximum outstanding tasks; 0 is unbounded.
+     * @param overflow What async() does when the queue is full.
+     */
+    void set_capacity(size_t capacity, ThreadPool::Overflow overflow = ThreadPool::Overflow::Block);
+
+    /**
+     * @brief Returns the number of tasks refused or discarded because the queue was full.
+     */
+    uint64_t rejected() const { return rejected_.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Runs this queue's work through @p target instead of the pool.
+     *
+     * A serial queue submits its drain to @p target as one task, and a
+     * concurrent queue submits each of its tasks there, so a serial target
+     * runs at most one of its children's tasks at a time and a concurrent
+     * target bounds them by its own limits. Many serial queues nested under
+     * one target put a single entry at a time in the pool instead of one
+     * per queue. Work runs with the target's QoS, ordering within each queue
+     * is unchanged, and targets can be nested.
+     *
+     * Call before submitting work; tasks already queued keep their route.
+     * @p target must outlive this queue, and a queue must not end up
+     * targeting itself.
+     *
+     * @param target Queue to submit work through.
+     */
+    void set_target(Queue& target);
+
+    /**
+     * @brief Submits work straight to the pool again, undoing set_target().
+     */
+    void reset_target();
+
+#if defined(__cpp_impl_coroutine)
+    struct ScheduleAwaiter;
+    struct DelayAwaiter;
+
+    /**
+     * @brief Returns an awaitable that resumes the coroutine on this queue.
+     *
+     * `co_await queue.schedule();` submits the coroutine's continuation; like a
+     * future continuation it is not subject to the queue's capacity.
+     */
+    ScheduleAwaiter schedule();
+
+    /**
+     * @brief Returns an awaitable that resumes the coroutine on this queue after @p delay.
+     *
+     * `co_await queue.after(10ms);` schedules the continuation on the shared Timer.
+     */
+    DelayAwaiter after(std::chrono::milliseconds delay);
+#endif
+
 private:
+    friend class Group;
+    friend class Reactor;
+    friend class Source;
+    friend class Timer;
+    template <typename>
+    friend struct detail::Continuation;
+
+    /**
+     * @brief Submits a task without applying the queue's capacity.
+     *
+     * Used for runs that the library submits on the caller's behalf, such as
+     * timer ticks, source and reactor deliveries, group notifications,
+     * future continuations and coroutine resumptions: dropping one would
+     * leave its owner waiting for a run that never comes, and blocking would
+     * stall the thread delivering it.
+     */
+    void enqueue(Task task) { dispatch(std::move(task), nullptr); }
+
+    /**
+     * @brief Submits a batch without applying the queue's capacity; see enqueue().
+     */
+    template <typename Range>
+    void enqueue_batch(Range&& range) {
+        if (type_ == Type::Concurrent) {
+            if constexpr (std::is_same<std::decay_t<Range>, std::vector<Task>>::value) {
+                // Already Tasks in one buffer, such as the timer's reused one.
+                dispatch_batch(range.data(), range.size());
+            } else {
+                std::vector<Task> tasks;
+                for (auto&& task : range) {
+                    tasks.emplace_back(std::move(task));
+                }
+                dispatch_batch(tasks.data(), tasks.size());
+            }
+            return;
+        }
+
+        Node* first = nullptr;
+        Node* last = nullptr;
+        for (auto&& task : range) {
+            Node* node = make_node(Job(std::move(task)));
+            if (last) {
+                last->next.store(node, std::memory_order_relaxed);
+            } else {
+                first = node;
+            }
+            last = node;
+        }
+        if (first) {
+            push(first, last);
+        }
+    }
+
+
+    /**
+     * @brief Internal form of a submitted task.
+     *
+     * Same as ThreadPool::Task: it holds a Task plus a few words of context
+     * inline, so wrappers such as the one used for groups do not allocate.
+     */
+    using Job = ThreadPool::Task;
+
+    /**
+     * @brief Node of the intrusive MPSC task list of a serial queue.
+     */
+    struct Node {
+        std::atomic<Node*> next{nullptr};
+        Job task;
+        Group* group = nullptr;  ///< Left once the task has run.
+        bool counted = false;    ///< Holds a slot of the queue's capacity.
+    };
+
+    struct NodePool;
+    struct NodeCache;
+
+    /**
+     * @brief Task of a concurrent queue held back by a pending barrier.
+     */
+    struct Pending {
+        Task task;
+        Group* group;
+        bool barrier;
+        bool counted;
+    };
+
+    // High bit of reads_: a barrier is queued or running and new tasks go to backlog_.
+    static constexpr size_t kBarrierPending = ~(~size_t(0) >> 1);
+
+    Queue(std::string name, Type type, ThreadPool::QoS qos, bool barriers);
+
     static std::string generate_name() {
         static std::atomic<int> counter{0};
         return "queue_" + std::to_string(counter++);
     }
-    
-    void submit_next();
+
+    static NodePool& node_pool();
+    static NodeCache& node_cache();
+    static Node* make_node(Job task, Group* group = nullptr, bool counted = false);
+    static void free_nodes(Node* first, Node* last, size_t count);
+
+    void push(Node* first, Node* last);
+    Node* pop();
+    bool empty() const;
+
+    void apply_range(size_t n, void (*invoke)(void*, size_t, size_t), void* context);
+
+    void schedule_drain();
+    void drain();
+    void drain_tasks();
+    template <typename F>
+    void dispatch(F&& task, Group* group, bool counted = false);
+    void dispatch_batch(Task* tasks, size_t count);
+    template <typename F>
+    Job make_read(F&& task, Group* group, bool counted = false);
+    template <typename F>
+    void submit(F&& job);
+    void finish_read();
+    void finish_barrier();
+    void advance();
+    void wait_for(Task task, bool barrier);
+    void execute(Job& job);
+    bool admit(bool wait);
+    bool reserve(size_t capacity);
+    void release();
+    bool hold(Task task, Group* group, bool displace);
+    void run_oldest();
 
     std::string name_;
     Type type_;
     ThreadPool::QoS qos_;
+    // False for the global queues: no barriers, so tasks skip reads_.
+    bool barriers_;
+    std::atomic<Queue*> target_;
+
+    // Vyukov intrusive MPSC list: producers exchange head_, the draining worker owns tail_.
+    std::atomic<Node*> head_;
+    Node* tail_;
+    Node stub_;
+    std::atomic<bool> scheduled_;
+    std::atomic<int> active_drains_;
+
+    std::atomic<size_t> quantum_tasks_;
+    std::atomic<std::chrono::microseconds::rep> quantum_time_;
 
-    std::mutex mutex_;
-    std::queue<Task> tasks_;
-    bool is_running_;
+    std::atomic<std::thread::id> running_thread_id_;
 
-    std::thread::id running_thread_id_;
+    // Concurrent queues: tasks in flight plus kBarrierPending; the rest is guarded by barrier_mutex_.
+    std::atomic<size_t> reads_;
+    std::mutex barrier_mutex_;
+    std::deque<Pending> backlog_;
+    bool barrier_running_;
+
+    // Bounded queues: depth_ counts outstanding counted tasks; submitters
+    // blocked on a full queue wait on space_. With Overflow::DropOldest the
+    // tasks wait in waiting_, and each submitted run takes the oldest one.
+    std::atomic<size_t> capacity_;
+    std::atomic<ThreadPool::Overflow> overflow_;
+    std::atomic<size_t> depth_;
+    std::atomic<uint64_t> rejected_;
+    detail::EventCount space_;
+    std::mutex waiting_mutex_;
+    std::deque<Pending> waiting_;
+
+    // Throughput reported by ThreadPool::stats().
+    detail::QueueCounters counters_;
+};
+
+namespace detail {
+
+template <>
+struct Continuation<Queue> {
+    template <typename F>
+    static void post(Queue& queue, F&& f) { queue.enqueue(Task(std::forward<F>(f))); }
+};
+
+} // namespace detail
+
+#if defined(__cpp_impl_coroutine)
+struct Queue::ScheduleAwaiter {
+    Queue& queue;
+
+    bool await_ready() const noexcept { return false; }
+    void await_suspend(std::coroutine_handle<> handle) {
+        queue.enqueue([handle] { handle.resume(); });
+    }
+    void await_resume() const noexcept {}
+};
+
+struct Queue::DelayAwaiter {
+    Queue& queue;
+    std::chrono::steady_clock::time_point when;
+
+    bool await_ready() const noexcept { return false; }
+    void await_suspend(std::coroutine_handle<> handle) {
+        Timer::instance().schedule([handle] { handle.resume(); }, when, queue);
+    }
+    void await_resume() const noexcept {}
 };
 
+inline Queue::ScheduleAwaiter Queue::schedule() {
+    return ScheduleAwaiter{*this};
+}
+
+inline Queue::DelayAwaiter Queue::after(std::chrono::milliseconds delay) {
+    return DelayAwaiter{*this, std::chrono::steady_clock::now() + delay};
+}
+#endif
+
 /**
  * @brief Returns a global queue with the specified QoS.
  *
@@ -0,0 +1,179 @@
+/*
+ * Copyright 2025 Denis Silko
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace turboq {
+
+class Queue;
+
+/**
+ * @brief Delivers file descriptor readiness to queues from a dedicated epoll thread.
+ *
+ * Descriptors are registered edge-triggered, so a handler must read or
+ * write until the call would block. Readiness that arrives while a handler
+ * run is queued or running is OR-ed into the next run; runs for one
+ * descriptor never overlap, even on a concurrent queue. Once warmed up,
+ * the event thread allocates nothing per event: a run is a Task that fits
+ * inline, and serial queues take its node from their recycled pool. Runs
+ * are submitted after the event thread has released its lock, so handlers
+ * may watch or cancel freely.
+ *
+ * Pipes, sockets, eventfd, timerfd and anything else epoll accepts can be
+ * watched. Only available on Linux; elsewhere watch() always fails.
+ */
+class Reactor {
+    struct Registration;
+    struct Link;
+
+public:
+    /**
+     * @brief Readiness bits passed to handlers.
+     */
+    enum Event : uint32_t {
+        Read   = 1 << 0,  ///< Data to read, or the peer closed its end.
+        Write  = 1 << 1,  ///< Room to write.
+        Hangup = 1 << 2,  ///< The peer hung up.
+        Error  = 1 << 3   ///< An error is pending on the descriptor.
+    };
+
+    /**
+     * @brief Called on the queue with the Event bits seen since the previous run.
+     */
+    using Handler = std::function<void(uint32_t events)>;
+
+    /**
+     * @brief Refers to a registration and allows removing it.
+     *
+     * Dropping the handle leaves the registration in place. A handle may
+     * outlive its Reactor; it then reports the registration as inactive.
+     * A default-constructed or failed handle refers to nothing.
+     */
+    class Handle {
+    public:
+        Handle() = default;
+
+        /**
+         * @brief Stops watching the descriptor.
+         *
+         * A handler run already queued or running completes, later ones are
+         * skipped. The descriptor itself is not closed. Safe to call from
+         * the handler.
+         *
+         * @return true if the registration was active.
+         */
+        bool cancel();
+
+        /**
+         * @brief Returns true until cancel() is called.
+         */
+        bool active() const;
+
+        explicit operator bool() const { return registration_ != nullptr; }
+
+    private:
+        friend class Reactor;
+
+        Handle(std::weak_ptr<Link> reactor, std::shared_ptr<Registration> registration)
+            : reactor_(std::move(reactor)), registration_(std::move(registration)) {}
+
+        std::weak_ptr<Link> reactor_;
+        std::shared_ptr<Registration> registration_;
+    };
+
+    /**
+     * @brief Returns the shared Reactor.
+     */
+    static Reactor& instance();
+
+    /**
+     * @brief Returns whether readiness notification is available on this platform.
+     */
+    static bool supported();
+
+    /**
+     * @brief Creates the epoll instance and starts the event thread.
+     */
+    Reactor();
+
+    /**
+     * @brief Stops the event thread. Registrations are dropped, descriptors stay open.
+     */
+    ~Reactor();
+
+    Reactor(const Reactor&) = delete;
+    Reactor& operator=(const Reactor&) = delete;
+
+    /**
+     * @brief Starts watching @p fd for @p events and runs @p handler on @p queue.
+     *
+     * If @p fd is already ready, the handler runs once right away. A
+     * descriptor can only be registered once at a time.
+     *
+     * @param fd Descriptor to watch; should be non-blocking.
+     * @param events Read, Write or both; Hangup and Error are always reported,
+     *        though a write-only watch only sees Hangup once the peer closed
+     *        both directions.
+     * @param queue Queue that runs the handler; must outlive the registration.
+     * @param handler Called with the Event bits that became ready.
+     * @return Handle of the registration, empty if epoll refused the descriptor.
+     */
+    Handle watch(int fd, uint32_t events, Queue& queue, Handler handler);
+
+private:
+    /**
+     * @brief Lets handles reach the reactor only while it is alive.
+     *
+     * The destructor clears @c reactor under @c mutex, so a handle holding
+     * the mutex can use the reactor safely.
+     */
+    struct Link {
+        std::mutex mutex;
+        Reactor* reactor;
+
+        explicit Link(Reactor* r) : reactor(r) {}
+    };
+
+    bool remove(const std::shared_ptr<Registration>& registration);
+    void run();
+    static bool claim(Registration& registration, uint32_t events);
+    static void deliver(const std::shared_ptr<Registration>& registration);
+    static void fire(const std::shared_ptr<Registration>& registration);
+
+    int epoll_fd_;
+    int wake_fd_;
+    std::atomic<bool> stop_;
+    std::shared_ptr<Link> link_;
+
+    std::mutex mutex_;
+    std::unordered_map<Registration*, std::shared_ptr<Registration>> registrations_;
+    // Removed registrations stay alive until the event thread is past the
+    // epoll_wait() batch that may still refer to them.
+    std::vector<std::shared_ptr<Registration>> retired_;
+
+    std::thread worker_;
+};
+
+} // namespace turboq
@@ -0,0 +1,108 @@
+/*
+ * Copyright 2025 Denis Silko
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+
+namespace turboq {
+
+class Queue;
+
+/**
+ * @brief Coalesces high-frequency signals into handler runs on a Queue.
+ *
+ * Each merge() folds a value into the pending data with one atomic
+ * operation. At most one handler run is queued or running at a time; it
+ * takes the merged value, resets it to zero and passes it to the handler.
+ * Values merged while the handler runs are delivered by the next run, and
+ * runs never overlap, even on a concurrent queue.
+ *
+ * A merged value of zero is ignored, so the handler only sees non-zero data.
+ *
+ * @note The queue must outlive the Source.
+ */
+class Source {
+public:
+    /**
+     * @brief Defines how merged values combine with the pending data.
+     */
+    enum class Merge {
+        Add,     ///< Values are summed, e.g. counts of events.
+        Or,      ///< Values are OR-ed, e.g. sets of flags.
+        Replace  ///< The latest value wins.
+    };
+
+    using Handler = std::function<void(uint64_t)>;
+
+    /**
+     * @brief Constructs a Source that runs @p handler on @p queue.
+     *
+     * @param queue Queue to run the handler on.
+     * @param merge How merged values combine.
+     * @param handler Called with the merged data.
+     */
+    Source(Queue& queue, Merge merge, Handler handler);
+
+    /**
+     * @brief Cancels the source and waits for a queued or running handler.
+     *
+     * Must not be called from the handler.
+     */
+    ~Source();
+
+    Source(const Source&) = delete;
+    Source& operator=(const Source&) = delete;
+
+    /**
+     * @brief Folds @p data into the pending data and schedules the handler if needed.
+     *
+     * Safe to call from any thread.
+     *
+     * @param data Value to merge; zero is ignored.
+     */
+    void merge(uint64_t data);
+
+    /**
+     * @brief Stops delivery: later merges are ignored and pending data is dropped.
+     *
+     * A handler run already in progress completes.
+     */
+    void cancel();
+
+    /**
+     * @brief Returns whether cancel() has been called.
+     */
+    bool cancelled() const { return cancelled_.load(std::memory_order_acquire); }
+
+private:
+    void fire();
+
+    Queue& queue_;
+    Merge merge_;
+    Handler handler_;
+
+    std::atomic<uint64_t> data_;
+    // A handler run is queued or running; cleared once it has returned.
+    std::atomic<bool> scheduled_;
+    // fire() still reads the source after releasing scheduled_.
+    std::atomic<int> active_;
+    std::atomic<bool> cancelled_;
+};
+
+} // namespace turboq
@@ -0,0 +1,160 @@
+/*
+ * Copyright 2025 Denis Silko
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#ifndef TURBOQ_TASK_INLINE_SIZE
+#define TURBOQ_TASK_INLINE_SIZE 64
+#endif
+
+namespace turboq {
+
+/**
+ * @brief Move-only type-erased callable with inline storage.
+ *
+ * Callables that fit into @p Capacity bytes and are nothrow move constructible
+ * are stored inline without any heap allocation; larger ones fall back to a
+ * single heap allocation. Unlike std::function, move-only captures such as
+ * std::unique_ptr are supported.
+ *
+ * @tparam Capacity Size of the inline buffer in bytes.
+ */
+template <size_t Capacity>
+class BasicTask {
+public:
+    static constexpr size_t capacity = Capacity;
+
+    BasicTask() noexcept = default;
+    BasicTask(std::nullptr_t) noexcept {}
+
+    /**
+     * @brief Wraps a callable invocable as `void()`.
+     */
+    template <typename F,
+              typename Fn = std::decay_t<F>,
+              typename = std::enable_if_t<!std::is_same<Fn, BasicTask>::value &&
+                                          std::is_invocable<Fn&>::value>>
+    BasicTask(F&& f) {
+        if constexpr (fits_inline<Fn>()) {
+            new (storage_) Fn(std::forward<F>(f));
+            vtable_ = &inline_vtable<Fn>;
+        } else {
+            new (storage_) Fn*(new Fn(std::forward<F>(f)));
+            vtable_ = &heap_vtable<Fn>;
+        }
+    }
+
+    BasicTask(BasicTask&& other) noexcept : vtable_(other.vtable_) {
+        if (vtable_) {
+            vtable_->move(storage_, other.storage_);
+            other.vtable_ = nullptr;
+        }
+    }
+
+    BasicTask& operator=(BasicTask&& other) noexcept {
+        if (this != &other) {
+            reset();
+            if (other.vtable_) {
+                other.vtable_->move(storage_, other.storage_);
+                vtable_ = other.vtable_;
+                other.vtable_ = nullptr;
+            }
+        }
+        return *this;
+    }
+
+    BasicTask& operator=(std::nullptr_t) noexcept {
+        reset();
+        return *this;
+    }
+
+    BasicTask(const BasicTask&) = delete;
+    BasicTask& operator=(const BasicTask&) = delete;
+
+    ~BasicTask() { reset(); }
+
+    /**
+     * @brief Invokes the stored callable.
+     *
+     * @throws std::bad_function_call if the task is empty.
+     */
+    void operator()() {
+        if (!vtable_)
+            throw std::bad_function_call();
+        vtable_->invoke(storage_);
+    }
+
+    explicit operator bool() const noexcept { return vtable_ != nullptr; }
+
+private:
+    struct VTable {
+        void (*invoke)(void* storage);
+        void (*move)(void* dst, void* src) noexcept;
+        void (*destroy)(void* storage) noexcept;
+    };
+
+    template <typename Fn>
+    static constexpr bool fits_inline() {
+        return sizeof(Fn) <= Capacity &&
+               alignof(Fn) <= alignof(std::max_align_t) &&
+               std::is_nothrow_move_constructible<Fn>::value;
+    }
+
+    template <typename Fn>
+    static constexpr VTable inline_vtable = {
+        [](void* storage) { (*std::launder(static_cast<Fn*>(storage)))(); },
+        [](void* dst, void* src) noexcept {
+            Fn* from = std::launder(static_cast<Fn*>(src));
+            new (dst) Fn(std::move(*from));
+            from->~Fn();
+        },
+        [](void* storage) noexcept { std::launder(static_cast<Fn*>(storage))->~Fn(); }
+    };
+
+    template <typename Fn>
+    static constexpr VTable heap_vtable = {
+        [](void* storage) { (**static_cast<Fn**>(storage))(); },
+        [](void* dst, void* src) noexcept { new (dst) Fn*(*static_cast<Fn**>(src)); },
+        [](void* storage) noexcept { delete *static_cast<Fn**>(storage); }
+    };
+
+    void reset() noexcept {
+        if (vtable_) {
+            vtable_->destroy(storage_);
+            vtable_ = nullptr;
+        }
+    }
+
+    static_assert(Capacity >= sizeof(void*), "BasicTask capacity must hold at least a pointer");
+
+    alignas(std::max_align_t) unsigned char storage_[Capacity];
+    const VTable* vtable_ = nullptr;
+};
+
+/**
+ * @brief Task type accepted by Queue and Timer.
+ *
+ * The inline buffer size is set with the TURBOQ_TASK_INLINE_SIZE CMake option.
+ */
+using Task = BasicTask<TURBOQ_TASK_INLINE_SIZE>;
+
+} // namespace turboq
@@ -16,13 +16,24 @@
 
 #pragma once
 
-#include <functional>
-#include <queue>
+#include <TurboQ/task.hpp>
+#include <TurboQ/future.hpp>
+#include <TurboQ/detail/mpmc_ring.hpp>
+#include <TurboQ/detail/metrics.hpp>
+#include <TurboQ/detail/event_count.hpp>
+
+#include <deque>
 #include <mutex>
 #include <thread>
 #include <vector>
+#include <memory>
+#include <atomic>
 #include <condition_variable>
 #include <iostream>
+#include <array>
+#include <chrono>
+#include <string>
+#include <iterator>
 
 namespace turboq {
 
@@ -44,7 +55,175 @@ public:
         Background      = 0  ///< Lowest priority, long-running background tasks.
     };
 
-    using Task = std::function<void()>; ///< Represents a task to be executed.
+    /**
+     * @brief Defines how tasks are distributed between worker threads.
+     */
+    enum class Scheduler {
+        GlobalQueue,  ///< All workers share one lock-free ring per QoS level.
+        WorkStealing  ///< Each worker owns a deque; idle workers steal from the others.
+    };
+
+    /**
+     * @brief Defines how workers choose between QoS levels.
+     */
+    enum class Policy {
+        Strict,  ///< Always the highest pending level; lower levels can starve.
+        Fair     ///< Weighted fair shares per level, FIFO within a level.
+    };
+
+    /**
+     * @brief Defines how worker threads are pinned to CPUs.
+     */
+    enum class Affinity {
+        None,  ///< Workers are not pinned.
+        Core,  ///< Each worker is pinned to a single CPU.
+        Node   ///< Each worker is pinned to the CPUs of its NUMA node (or all of Options::cpus).
+    };
+
+    /**
+     * @brief Defines what happens to a task submitted while its level or queue is full.
+     */
+    enum class Overflow {
+        Block,       ///< The submitter waits for room.
+        DropOldest,  ///< The oldest waiting task is discarded to make room.
+        DropNewest   ///< The submitted task is discarded.
+    };
+
+    /**
+     * @brief Construction options for ThreadPool.
+     *
+     * An idle worker polls for work @c spin_count times with a CPU pause,
+     * then @c yield_count times with a thread yield, and only then parks.
+     * While a worker is polling, submitters do not wake parked ones, so
+     * bursts of short tasks avoid a futex wake per submission. Set both
+     * to zero to park immediately.
+     *
+     * With @c max_threads above @c threads the pool is elastic: @c threads
+     * workers always run, and up to @c max_threads - @c threads extra ones
+     * are started when tasks stay queued for @c spawn_after while no worker
+     * is idle, or when a worker enters a BlockingScope. Extra workers exit
+     * after @c idle_timeout without work.
+     *
+     * With Policy::Fair every pending level gets a share of each worker
+     * proportional to its entry in @c weights (indexed by QoS), so a steady
+     * stream of high QoS work delays lower levels instead of starving them.
+     * Workers then also take their own tasks oldest first.
+     *
+     * The first @c reserved_interactive workers only run UserInteractive
+     * tasks, so those start promptly even when the rest of the pool is busy.
+     * At least one worker is always left for the other levels.
+     *
+     * A nonzero entry of @c capacity (indexed by QoS) bounds the tasks
+     * waiting at that level, and @c overflow picks what submit() and
+     * submit_bulk() do once it is reached; try_submit() fails instead. With
+     * Overflow::DropOldest the oldest task submitted to the level that has
+     * not started is discarded right away and the new one takes its turn;
+     * if none is waiting, the new task is discarded. Work of Queues counts
+     * towards the limit but is never held back or dropped by it; bound a
+     * Queue with Queue::set_capacity(). Discarded tasks are counted in
+     * LevelStats::rejected.
+     *
+     * With @c numa set, workers are spread over the NUMA nodes found in sysfs
+     * and every node gets its own task queues. Submissions go to the node of
+     * the submitting thread, and a worker only takes tasks from another node
+     * when nothing is queued on its own.
+     */
+    struct Options {
+        size_t threads = std::thread::hardware_concurrency(); ///< Number of worker threads; 0 is taken as 1.
+        Scheduler scheduler = Scheduler::GlobalQueue;         ///< Task distribution strategy.
+        size_t ring_capacity = 1024;                          ///< Per-QoS ring size (GlobalQueue).
+        bool metrics = false;                                 ///< Sample latencies for stats().
+        Affinity affinity = Affinity::None;                   ///< Worker pinning (Linux only).
+        std::vector<int> cpus;                                ///< CPUs to place workers on; empty means all allowed.
+        bool numa = false;                                    ///< Split into per-NUMA-node sub-pools.
+        size_t spin_count = 256;                              ///< Idle polls with a CPU pause before yielding.
+        size_t yield_count = 8;                               ///< Idle polls with a thread yield before parking.
+        size_t max_threads = 0;                               ///< Elastic upper bound; <= threads disables growth.
+        std::chrono::milliseconds spawn_after{10};            ///< Saturation time before an extra worker starts.
+        std::chrono::milliseconds idle_timeout{5000};         ///< Idle time before an extra worker exits.
+        Policy policy = Policy::Strict;                       ///< How workers choose between QoS levels.
+        std::array<unsigned, 4> weights{{1, 2, 4, 8}};        ///< Policy::Fair share per QoS level.
+        size_t reserved_interactive = 0;                      ///< Workers that only run UserInteractive tasks.
+        std::array<size_t, 4> capacity{};                     ///< Waiting tasks per QoS level; 0 is unbounded.
+        Overflow overflow = Overflow::Block;                  ///< Policy of submit() at a full level.
+    };
+
+    /**
+     * @brief Marks the calling worker as blocked for the lifetime of the scope.
+     *
+     * Wrap waits on I/O or on other pool tasks in a BlockingScope. In an
+     * elastic pool, a replacement worker is started right away if fewer than
+     * Options::threads workers would be left running tasks. Outside an
+     * elastic pool's worker thread it does nothing.
+     */
+    class BlockingScope {
+    public:
+        BlockingScope();
+        ~BlockingScope();
+
+        BlockingScope(const BlockingScope&) = delete;
+        BlockingScope& operator=(const BlockingScope&) = delete;
+
+    private:
+        ThreadPool* pool_;
+    };
+
+    /**
+     * @brief Log2 histogram of durations.
+     *
+     * Bucket i counts durations below 2^i nanoseconds that did not fit bucket i - 1.
+     */
+    struct Histogram {
+        std::array<uint64_t, detail::kHistogramBuckets> buckets{};
+
+        /**
+         * @brief Returns the number of recorded samples.
+         */
+        uint64_t count() const;
+
+        /**
+         * @brief Returns the upper bound of the bucket holding quantile @p q.
+         *
+         * @param q Quantile in [0, 1], e.g. 0.99.
+         */
+        std::chrono::nanoseconds percentile(double q) const;
+    };
+
+    /**
+     * @brief Snapshot of one QoS level.
+     */
+    struct LevelStats {
+        size_t depth = 0;     ///< Tasks waiting to run.
+        uint64_t executed = 0; ///< Tasks run so far.
+        uint64_t rejected = 0; ///< Tasks refused or discarded because the level was full.
+        Histogram wait;       ///< Enqueue-to-start latency of sampled tasks (Options::metrics only).
+        Histogram run;        ///< Execution time of sampled tasks (Options::metrics only).
+    };
+
+    /**
+     * @brief Snapshot of one live Queue.
+     */
+    struct QueueStats {
+        std::string name;               ///< Queue name.
+        uint64_t executed = 0;          ///< Tasks run so far.
+        std::chrono::nanoseconds busy{0}; ///< Worker time spent on the queue, estimated from samples.
+    };
+
+    /**
+     * @brief Snapshot returned by stats().
+     */
+    struct Stats {
+        std::array<LevelStats, 4> levels;  ///< Indexed by static_cast<size_t>(QoS).
+        std::vector<QueueStats> queues;    ///< Live queues, which run on instance() (Options::metrics only).
+    };
+
+    /**
+     * @brief Represents a task to be executed.
+     *
+     * Large enough to hold a turboq::Task plus a few words of context inline,
+     * so that wrappers built by Queue never allocate.
+     */
+    using Task = BasicTask<sizeof(turboq::Task) + 32>;
 
     /**
      * @brief Returns a singleton instance of ThreadPool.
@@ -54,6 +233,16 @@ public:
      */
     static ThreadPool& instance(size_t threads = std::thread::hardware_concurrency());
 
+    /**
+     * @brief Returns a singleton instance of ThreadPool.
+     *
+     * Only the first call creates the pool; options passed to later calls are ignored.
+     *
+     * @param options Construction options for the shared pool.
+     * @return Reference to the ThreadPool instance.
+     */
+    static ThreadPool& instance(const Options& options);
+
     /**
      * @brief Constructs a ThreadPool with a specified number of threads.
      *
@@ -61,6 +250,13 @@ public:
      */
     explicit ThreadPool(size_t threads = std::thread::hardware_concurrency());
 
+    /**
+     * @brief Constructs a ThreadPool with the given options.
+     *
+     * @param options Number of threads and scheduler mode.
+     */
+    explicit ThreadPool(const Options& options);
+
     /**
      * @brief Destroys the ThreadPool and joins all worker threads.
      */
@@ -74,25 +270,278 @@ public:
      */
     void submit(Task task, QoS qos = QoS::Utility);
 
+    /**
+     * @brief Submits a task unless its QoS level is full.
+     *
+     * Never blocks and never discards other tasks, whatever Options::overflow says.
+     *
+     * @param task The task to execute.
+     * @param qos Quality of Service for task priority. Default is Utility.
+     * @return False, counting the task as rejected, if the level is at its capacity.
+     */
+    bool try_submit(Task task, QoS qos = QoS::Utility);
+
+    /**
+     * @brief Submits a callable and returns a Future for its result.
+     *
+     * Exceptions thrown by @p f are stored in the Future and rethrown by Future::get().
+     * If the pool discards the task because it is full (see Options::capacity), the
+     * Future holds std::future_error with std::future_errc::broken_promise.
+     *
+     * @param f Callable taking no arguments.
+     * @param qos Quality of Service for task priority. Default is Utility.
+     * @return Future of the callable's result.
+     */
+    template <typename F>
+    auto submit_result(F&& f, QoS qos = QoS::Utility) {
+        auto packaged = detail::FutureAccess::package(std::forward<F>(f));
+        submit(std::move(packaged.first), qos);
+        return std::move(packaged.second);
+    }
+
+    /**
+     * @brief Submits a batch of tasks with the same QoS.
+     *
+     * The whole batch is enqueued at once and only as many parked workers
+     * are woken as the batch needs. Elements are moved out of @p range.
+     * At a level with a capacity the tasks are submitted one by one.
+     *
+     * @param range Any iterable range of callables convertible to Task.
+     * @param qos Quality of Service for task priority. Default is Utility.
+     */
+    template <typename Range>
+    void submit_bulk(Range&& range, QoS qos = QoS::Utility) {
+        if (capacity_[static_cast<size_t>(qos)] > 0) {
+            for (auto&& task : range) {
+                submit(Task(std::move(task)), qos);
+            }
+            return;
+        }
+        enqueue_bulk(std::forward<Range>(range), qos);
+    }
+
+    /**
+     * @brief Returns the number of running worker threads.
+     */
+    size_t size() const { return live_.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Returns whether the pool records latencies and per-queue throughput.
+     */
+    bool metrics_enabled() const { return metrics_.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Turns latency and per-queue throughput recording on or off.
+     *
+     * Useful for the shared instance(), whose options are fixed by the first
+     * caller. Per-QoS depth and executed counts are always kept.
+     */
+    void set_metrics_enabled(bool enabled) { metrics_.store(enabled, std::memory_order_relaxed); }
+
+    /**
+     * @brief Returns a snapshot of the pool's counters.
+     *
+     * Workers keep their counters privately; this merges them, so it may
+     * miss tasks that finish while it runs.
+     */
+    Stats stats() const;
+
 private:
-    struct PrioritizedTask {
+    friend class Queue;
+
+    static constexpr size_t kQoSLevels = 4;
+
+    /**
+     * @brief Queued task with its enqueue time in nanoseconds (0 if not sampled).
+     */
+    struct Item {
         Task task;
-        QoS qos;
-        
-        PrioritizedTask(Task t, QoS q);
+        uint64_t enqueued = 0;
+    };
 
-        bool operator<(const PrioritizedTask& other) const {
-            return static_cast<int>(qos) < static_cast<int>(other.qos);
+    /**
+     * @brief Enqueues a task without applying the level's capacity; used by Queue.
+     */
+    void enqueue(Task task, QoS qos) { enqueue(Item{std::move(task), enqueue_time()}, static_cast<size_t>(qos)); }
+
+    /**
+     * @brief Enqueues @p item, counting it as pending unless @p reserved says reserve() already did.
+     */
+    void enqueue(Item item, size_t level, bool reserved = false);
+
+    /**
+     * @brief Enqueues a batch without applying the level's capacity; used by Queue.
+     */
+    template <typename Range>
+    void enqueue_bulk(Range&& range, QoS qos) {
+        auto level = static_cast<size_t>(qos);
+        auto enqueued = enqueue_time();
+
+        // Count the batch before any of it becomes visible to workers.
+        auto total = static_cast<size_t>(std::distance(std::begin(range), std::end(range)));
+        if (total == 0)
+            return;
+        pending_[level].fetch_add(total, std::memory_order_seq_cst);
+
+        if (scheduler_ == Scheduler::WorkStealing) {
+            auto& queue = *local_queues_[local_queue_index()];
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            for (auto&& task : range) {
+                queue.tasks[level].push_back(Item{Task(std::move(task)), enqueued});
+            }
+        } else {
+            auto& shared = level_at(submit_node(), level);
+            std::unique_lock<std::mutex> overflow(shared.overflow_mutex, std::defer_lock);
+            for (auto&& task : range) {
+                Item item{Task(std::move(task)), enqueued};
+                // Once the ring is full the rest of the batch goes to the overflow deque.
+                if (!overflow.owns_lock()) {
+                    if (shared.overflow_size.load(std::memory_order_acquire) == 0 &&
+                        shared.ring.try_push(std::move(item)))
+                        continue;
+                    overflow.lock();
+                }
+                shared.overflow.push_back(std::move(item));
+                shared.overflow_size.fetch_add(1, std::memory_order_release);
+            }
         }
+
+        publish(level, total);
+    }
+
+    /**
+     * @brief Counters of one worker, written only by that worker.
+     */
+    struct alignas(64) WorkerStats {
+        struct Level {
+            std::atomic<uint64_t> executed{0};
+            std::atomic<uint64_t> wait[detail::kHistogramBuckets]{};
+            std::atomic<uint64_t> run[detail::kHistogramBuckets]{};
+        };
+        Level levels[kQoSLevels];
     };
 
-    std::vector<std::thread> workers_;
-    std::priority_queue<PrioritizedTask> tasks_;
-    std::mutex mutex_;
-    std::condition_variable cv_;
-    bool stop_;
+    /**
+     * @brief Shared tasks of one QoS level used by Scheduler::GlobalQueue.
+     *
+     * Submissions go to the bounded lock-free ring; the mutex-guarded overflow
+     * deque takes tasks while the ring is full and until it has drained, so
+     * that tasks from one submitter stay in order.
+     */
+    struct Level {
+        detail::MPMCRing<Item> ring;
+        std::mutex overflow_mutex;
+        std::deque<Item> overflow;
+        std::atomic<size_t> overflow_size;
+
+        explicit Level(size_t capacity) : ring(capacity), overflow_size(0) {}
+    };
+
+    /**
+     * @brief Per-worker task deques used by Scheduler::WorkStealing.
+     *
+     * The owning worker pops from the back (the front with Policy::Fair),
+     * thieves take from the front.
+     */
+    struct WorkerQueue {
+        std::mutex mutex;
+        std::deque<Item> tasks[kQoSLevels];
+    };
+
+    /**
+     * @brief Worker thread slot; extra slots of an elastic pool are reused.
+     */
+    struct Slot {
+        std::thread thread;
+        std::vector<int> cpus;
+        bool running = false;
+    };
+
+    Scheduler scheduler_;
+    Policy policy_;
+    std::array<uint64_t, kQoSLevels> strides_;
+    size_t reserved_;
+    std::atomic<bool> metrics_;
+    std::atomic<bool> stop_;
+    size_t spin_count_;
+    size_t yield_count_;
+
+    // Workers: slots [0, min_threads_) always run, the rest come and go. Guarded by slots_mutex_.
+    std::mutex slots_mutex_;
+    std::vector<Slot> slots_;
+    size_t min_threads_;
+    std::atomic<size_t> live_;
+    std::atomic<size_t> blocked_;
+    std::chrono::milliseconds spawn_after_;
+    std::chrono::milliseconds idle_timeout_;
+
+    std::thread supervisor_;
+    std::mutex supervisor_mutex_;
+    std::condition_variable supervisor_cv_;
+    // The supervisor sleeps here while nothing is queued; publish() wakes it.
+    detail::EventCount supervisor_idle_;
+
+    // GlobalQueue keeps kQoSLevels levels per node; WorkStealing one queue per worker.
+    std::vector<std::unique_ptr<Level>> levels_;
+    std::vector<std::unique_ptr<WorkerQueue>> local_queues_;
+
+    // NUMA placement; a single node unless Options::numa is set.
+    size_t nodes_;
+    std::vector<size_t> worker_node_;
+    std::vector<std::vector<size_t>> node_workers_;
+    std::vector<int> cpu_node_;
+    // Victims per worker: itself, then its node, then the other nodes.
+    std::vector<std::vector<size_t>> steal_order_;
+    std::vector<size_t> steal_local_;
+    std::vector<std::unique_ptr<WorkerStats>> worker_stats_;
+    std::atomic<size_t> pending_[kQoSLevels];
+    // Idle workers: polling ones are counted in spinning_, parked ones wait on parking_.
+    // Reserved UserInteractive workers are not counted and park on reserved_parking_.
+    std::atomic<size_t> spinning_;
+    detail::EventCount parking_;
+    detail::EventCount reserved_parking_;
+    std::atomic<size_t> next_queue_;
+
+    // Bounded levels: submitters blocked on a full level wait on its space_.
+    // With Overflow::DropOldest submitted tasks wait in waiting_, and each
+    // queued run takes the oldest one of its level.
+    std::array<size_t, kQoSLevels> capacity_;
+    Overflow overflow_;
+    std::atomic<uint64_t> rejected_[kQoSLevels];
+    detail::EventCount space_[kQoSLevels];
+    std::mutex waiting_mutex_[kQoSLevels];
+    std::deque<Task> waiting_[kQoSLevels];
+
+    void worker_loop(size_t index);
+    size_t level_order(size_t index, size_t (&order)[kQoSLevels]) const;
+    void charge(size_t level);
+    bool try_pop(size_t index, Item& item, size_t& level);
+    bool try_pop_global(size_t index, Item& item, size_t& level);
+    bool try_pop_level(size_t node, size_t level, Item& item);
+    bool try_pop_local(size_t index, Item& item, size_t& level);
+    bool try_steal(size_t index, size_t first, size_t last, Item& item, size_t& level);
+    Level& level_at(size_t node, size_t level) { return *levels_[node * kQoSLevels + level]; }
+    size_t submit_node();
+    void place_workers(const Options& options);
+    bool elastic() const { return slots_.size() > min_threads_; }
+    void start_worker(size_t index);
+    bool spawn_worker();
+    bool retire_worker(size_t index);
+    void supervise();
+    uint64_t enqueue_time() const {
+        return metrics_enabled() && detail::sample() ? detail::now_ns() : 0;
+    }
+    size_t local_queue_index();
+    void publish(size_t level, size_t count);
+    bool has_pending() const;
+    bool has_work(size_t index) const;
+    bool admit(size_t level, bool wait);
+    bool reserve(size_t level);
+    bool hold(Task task, size_t level, bool displace);
+    void run_oldest(size_t level);
 
-    void worker_loop();
+    void execute(size_t index, size_t level, Item& item);
+    static void run(Task& task);
 };
 
 } // namespace turboq
@@ -16,9 +16,15 @@
 
 #pragma once
 
+#include <TurboQ/task.hpp>
+#include <TurboQ/detail/timing_wheel.hpp>
+
+#include <atomic>
 #include <functional>
 #include <chrono>
+#include <memory>
 #include <queue>
+#include <vector>
 #include <mutex>
 #include <condition_variable>
 #include <thread>
@@ -27,40 +33,253 @@ namespace turboq {
 
 class Queue;
 
+/**
+ * @brief Dispatches tasks to queues at a given time point from a dedicated thread.
+ *
+ * A task scheduled with a leeway may run anywhere in [when, when + leeway].
+ * The timer picks a fire time on a coarse grid inside that window, so that
+ * timers with overlapping windows share a wakeup, and on each wakeup it
+ * also takes every task whose window has already opened. The tasks of one
+ * wakeup reach each queue as a single batch.
+ */
 class Timer {
+    struct Entry;
+    struct Link;
+
 public:
-    using Task = std::function<void()>;
+    using Task = turboq::Task;
+
+    /**
+     * @brief Refers to a scheduled task and allows cancelling or moving it.
+     *
+     * Both operations are O(1): the entry left in the timer is invalidated
+     * lazily and dropped when it comes due, without reaching the queue, or
+     * earlier once such entries make up half of the timer's backlog.
+     * A handle may outlive its Timer; it then reports the task as no longer
+     * pending. A default-constructed handle refers to nothing.
+     */
+    class Handle {
+    public:
+        Handle() = default;
+
+        /**
+         * @brief Prevents the task from running and releases it.
+         *
+         * @return true if the task was pending; false if it already fired or was cancelled.
+         */
+        bool cancel();
+
+        /**
+         * @brief Moves a pending task to a new time point.
+         *
+         * @param when New time point for the task.
+         * @return true if the task was pending; false if it already fired or was cancelled.
+         */
+        bool reschedule(std::chrono::steady_clock::time_point when);
+
+        /**
+         * @brief Returns true while the task is waiting to fire.
+         */
+        bool pending() const;
+
+        explicit operator bool() const { return entry_ != nullptr; }
+
+    private:
+        friend class Timer;
+
+        Handle(std::weak_ptr<Link> timer, std::shared_ptr<Entry> entry)
+            : timer_(std::move(timer)), entry_(std::move(entry)) {}
+
+        std::weak_ptr<Link> timer_;
+        std::shared_ptr<Entry> entry_;
+    };
+
+    /**
+     * @brief Defines how pending timers are stored.
+     */
+    enum class Backend {
+        Heap,  ///< Binary heap ordered by deadline, O(log n) insert and expiry.
+        Wheel  ///< Hierarchical timing wheel with millisecond ticks, O(1) insert and expiry.
+    };
+
+    /**
+     * @brief Defines what a periodic task does about ticks that came due
+     *        while its previous run was still queued or running, or while
+     *        the timer was behind.
+     */
+    enum class Missed {
+        Skip,    ///< Drop them; the task runs at most once per wakeup.
+        CatchUp  ///< Run the task once for each of them, back to back.
+    };
+
+    /**
+     * @brief Returns the shared Timer used by Queue.
+     *
+     * Only the first call creates the timer; the backend passed to later calls is ignored.
+     *
+     * @param backend Storage used for pending timers. Default is Heap.
+     */
+    static Timer& instance(Backend backend = Backend::Heap);
+
+    /**
+     * @brief Constructs a Timer and starts its dispatch thread.
+     *
+     * @param backend Storage used for pending timers. Default is Heap.
+     */
+    explicit Timer(Backend backend = Backend::Heap);
 
-    static Timer& instance();
+    /**
+     * @brief Stops the dispatch thread. Pending tasks are discarded.
+     */
+    ~Timer();
+
+    Timer(const Timer&) = delete;
+    Timer& operator=(const Timer&) = delete;
+
+    /**
+     * @brief Schedules a task to be submitted to @p queue at @p when.
+     *
+     * @param task The task to execute.
+     * @param when Time point when the task should be submitted.
+     * @param queue Queue that executes the task.
+     * @param leeway How much later than @p when the task may be submitted.
+     * @return Handle that can cancel or reschedule the task.
+     */
+    Handle schedule(Task task,
+                    std::chrono::steady_clock::time_point when,
+                    Queue& queue,
+                    std::chrono::milliseconds leeway = std::chrono::milliseconds::zero());
 
-    void schedule(Task task,
-                  std::chrono::steady_clock::time_point when,
-                  Queue& queue);
+    /**
+     * @brief Schedules @p task to be submitted to @p queue at @p first and then every @p period.
+     *
+     * Ticks stay on the grid first + n * period however late a run starts,
+     * so the schedule does not drift. The entry is created once and
+     * re-armed in place; a tick allocates nothing beyond what submitting
+     * to @p queue costs. Runs of the task never overlap: ticks that come
+     * due while one is queued or running are handled per @p missed.
+     * Cancelling through the handle stops the series; the task is released
+     * once the timer has dropped its entry and no run is in flight.
+     *
+     * @param task The task to execute on every tick.
+     * @param first Time point of the first tick.
+     * @param period Interval between ticks; must be positive.
+     * @param queue Queue that executes the task; must outlive the series.
+     * @param missed What to do about ticks that could not run on time.
+     * @param leeway How much later than each tick the task may be submitted.
+     * @return Handle that can cancel the series or move its next tick.
+     */
+    Handle schedule_every(Task task,
+                          std::chrono::steady_clock::time_point first,
+                          std::chrono::milliseconds period,
+                          Queue& queue,
+                          Missed missed = Missed::Skip,
+                          std::chrono::milliseconds leeway = std::chrono::milliseconds::zero());
+
+    /**
+     * @brief Returns how many times the dispatch thread woke up and submitted tasks.
+     */
+    uint64_t wakeups() const { return wakeups_.load(std::memory_order_relaxed); }
 
 private:
-    struct ScheduledTask {
-        std::chrono::steady_clock::time_point when;
+    enum class Status : uint64_t {
+        Pending   = 0,
+        Fired     = 1,
+        Cancelled = 2
+    };
+
+    /**
+     * @brief Shared state of a scheduled task.
+     *
+     * The state packs a generation counter with a Status; rescheduling bumps
+     * the generation so that older ScheduledTask records no longer match.
+     */
+    struct Entry {
         Task task;
         Queue* queue;
+        std::chrono::milliseconds leeway;
+        std::atomic<uint64_t> state;
+
+        // Periodic tasks only: a zero period means a one-shot task.
+        std::chrono::milliseconds period{0};
+        Missed missed = Missed::Skip;
+        // Runs owed to the queue, including the one queued or running.
+        std::atomic<uint32_t> runs{0};
+
+        Entry(Task t, Queue* q, std::chrono::milliseconds l)
+            : task(std::move(t)), queue(q), leeway(l), state(0) {}
+    };
+
+    /**
+     * @brief Lets handles reach the timer only while it is alive.
+     *
+     * The destructor clears @c timer under @c mutex, so a handle holding the
+     * mutex can use the timer safely. @c stale counts records invalidated by
+     * cancel() or reschedule() that are still stored.
+     */
+    struct Link {
+        std::mutex mutex;
+        Timer* timer;
+        std::atomic<size_t> stale{0};
+
+        explicit Link(Timer* t) : timer(t) {}
+    };
+
+    /**
+     * @brief Record of one scheduled run.
+     *
+     * The task may be submitted from @c when on and is due at @c deadline,
+     * the grid point picked inside its leeway window.
+     */
+    struct ScheduledTask {
+        std::chrono::steady_clock::time_point when;
+        std::chrono::steady_clock::time_point deadline;
+        uint64_t generation;
+        std::shared_ptr<Entry> entry;
 
         bool operator>(const ScheduledTask& other) const {
-            return when > other.when;
+            return deadline > other.deadline;
         }
     };
 
+    Backend backend_;
+    std::chrono::steady_clock::time_point epoch_;
+
     std::priority_queue<ScheduledTask,
                         std::vector<ScheduledTask>,
                         std::greater<>> tasks_;
+    detail::TimingWheel<ScheduledTask> wheel_;
+    std::vector<ScheduledTask> expired_;
+    std::vector<ScheduledTask> rearm_;
+    std::atomic<uint64_t> wakeups_;
+    std::shared_ptr<Link> link_;
 
     std::mutex mutex_;
     std::condition_variable cv_;
+    std::chrono::steady_clock::time_point wake_at_;
     std::thread worker_;
     bool stop_;
 
-    Timer();
-    ~Timer();
+    static uint64_t make_state(uint64_t generation, Status status) {
+        return (generation << 2) | static_cast<uint64_t>(status);
+    }
 
+    void insert(ScheduledTask task);
     void run();
+    void submit(std::vector<ScheduledTask>& batch, std::vector<Task>& tasks);
+    void store(ScheduledTask task);
+    void purge_stale();
+    void forget_stale(size_t count);
+    static bool is_stale(const ScheduledTask& task);
+    static Task take_task(const std::shared_ptr<Entry>& entry);
+    static void run_periodic(const std::shared_ptr<Entry>& entry);
+    bool empty() const;
+    size_t size() const;
+    std::chrono::steady_clock::time_point next_deadline() const;
+    void collect_expired(std::chrono::steady_clock::time_point now);
+    uint64_t to_tick(std::chrono::steady_clock::time_point when) const;
+    std::chrono::steady_clock::time_point coalesce(std::chrono::steady_clock::time_point when,
+                                                   std::chrono::milliseconds leeway) const;
 };
 
 } 
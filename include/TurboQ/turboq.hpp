@@ -17,6 +17,15 @@
 #pragma once
 
 #include <TurboQ/version.hpp>
+#include <TurboQ/task.hpp>
+#include <TurboQ/future.hpp>
+#include <TurboQ/group.hpp>
 #include <TurboQ/queue.hpp>
+#include <TurboQ/reactor.hpp>
+#include <TurboQ/source.hpp>
 #include <TurboQ/thread_pool.hpp>
 #include <TurboQ/timer.hpp>
+
+#if defined(__cpp_impl_coroutine)
+#include <TurboQ/coroutine.hpp>
+#endif
@@ -0,0 +1,79 @@
+/*
+ * Copyright 2025 Denis Silko
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <TurboQ/group.hpp>
+#include <TurboQ/queue.hpp>
+#include <assert.h>
+
+namespace turboq {
+
+void Group::enter() {
+    count_.fetch_add(1, std::memory_order_relaxed);
+}
+
+void Group::leave() {
+    // Only the transition to zero takes the lock, so that a waiter which then
+    // destroys the group cannot observe zero before leave() is done with it.
+    size_t count = count_.load(std::memory_order_relaxed);
+    while (count > 1) {
+        if (count_.compare_exchange_weak(count, count - 1, std::memory_order_acq_rel,
+                                         std::memory_order_relaxed)) {
+            return;
+        }
+    }
+
+    std::vector<std::pair<Queue*, Task>> notifications;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        size_t previous = count_.fetch_sub(1, std::memory_order_acq_rel);
+        assert(previous > 0 && "Group::leave() without matching enter()");
+        if (previous != 1) {
+            return;
+        }
+        notifications.swap(notifications_);
+        cv_.notify_all();
+    }
+    for (auto& [queue, task] : notifications) {
+        queue->enqueue(std::move(task));
+    }
+}
+
+void Group::wait() {
+    ThreadPool::BlockingScope blocking;
+    std::unique_lock<std::mutex> lock(mutex_);
+    cv_.wait(lock, [this] { return count_.load(std::memory_order_acquire) == 0; });
+}
+
+bool Group::wait(std::chrono::milliseconds timeout) {
+    ThreadPool::BlockingScope blocking;
+    std::unique_lock<std::mutex> lock(mutex_);
+    return cv_.wait_for(lock, timeout, [this] {
+        return count_.load(std::memory_order_acquire) == 0;
+    });
+}
+
+void Group::notify(Queue& queue, Task task) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (count_.load(std::memory_order_acquire) != 0) {
+            notifications_.emplace_back(&queue, std::move(task));
+            return;
+        }
+    }
+    queue.enqueue(std::move(task));
+}
+
+} // namespace turboq
@@ -15,20 +15,50 @@
  */
 
 #include <TurboQ/queue.hpp>
+#include <TurboQ/group.hpp>
+#include <TurboQ/detail/teardown.hpp>
 #include <assert.h>
+#include <algorithm>
+#include <condition_variable>
+#include <exception>
 
 namespace turboq {
 
 Queue::Queue(std::string name,
              Type type,
              ThreadPool::QoS qos)
-    : name_(std::move(name)), type_(type), qos_(qos), is_running_(false) {}
+    : Queue(std::move(name), type, qos, true) {}
+
+Queue::Queue(std::string name,
+             Type type,
+             ThreadPool::QoS qos,
+             bool barriers)
+    : name_(std::move(name)), type_(type), qos_(qos), barriers_(barriers),
+      target_(nullptr), head_(&stub_), tail_(&stub_), scheduled_(false), active_drains_(0),
+      reads_(0), barrier_running_(false),
+      capacity_(0), overflow_(ThreadPool::Overflow::Block), depth_(0), rejected_(0),
+      counters_(name_) {
+    set_quantum(Quantum{});
+}
+
+Queue::~Queue() {
+    assert(running_thread_id_.load(std::memory_order_relaxed) != std::this_thread::get_id() &&
+           "a Queue must not be destroyed from one of its own tasks");
+    // A drain still reads the queue after releasing scheduled_, and concurrent
+    // tasks report back once they finish; both notify once they are done.
+    detail::wait_for_teardown([this] {
+        return !scheduled_.load(std::memory_order_seq_cst) &&
+               active_drains_.load(std::memory_order_seq_cst) == 0 &&
+               reads_.load(std::memory_order_seq_cst) == 0;
+    });
+    std::lock_guard<std::mutex> lock(barrier_mutex_);
+}
 
 Queue& Queue::global(ThreadPool::QoS qos) {
-    static Queue ui("global_ui", Queue::Type::Concurrent, ThreadPool::QoS::UserInteractive);
-    static Queue initiated("global_initiated", Queue::Type::Concurrent, ThreadPool::QoS::UserInitiated);
-    static Queue utility("global_utility", Queue::Type::Concurrent, ThreadPool::QoS::Utility);
-    static Queue background("global_background", Queue::Type::Concurrent, ThreadPool::QoS::Background);
+    static Queue ui("global_ui", Queue::Type::Concurrent, ThreadPool::QoS::UserInteractive, false);
+    static Queue initiated("global_initiated", Queue::Type::Concurrent, ThreadPool::QoS::UserInitiated, false);
+    static Queue utility("global_utility", Queue::Type::Concurrent, ThreadPool::QoS::Utility, false);
+    static Queue background("global_background", Queue::Type::Concurrent, ThreadPool::QoS::Background, false);
 
     switch (qos) {
         case ThreadPool::QoS::UserInteractive: return ui;
@@ -39,45 +69,302 @@ Queue& Queue::global(ThreadPool::QoS qos) {
     return utility;
 }
 
-void Queue::async(Task task) {
-    if (type_ == Type::Concurrent) {
-        ThreadPool::instance().submit(std::move(task), qos_);
+template <typename F>
+Queue::Job Queue::make_read(F&& task, Group* group, bool counted) {
+    return [this, group, counted, task = std::forward<F>(task)]() mutable {
+        struct Finish {
+            Queue* queue;
+            Group* group;
+            bool counted;
+            bool ran;
+            ~Finish() {
+                if (ran)
+                    detail::record(queue->counters_, 1);
+                if (group)
+                    group->leave();
+                if (counted)
+                    queue->release();
+                if (queue->barriers_)
+                    queue->finish_read();
+            }
+        } finish{this, group, counted, true};
+        task();
+    };
+}
+
+template <typename F>
+void Queue::submit(F&& job) {
+    Queue* target = target_.load(std::memory_order_acquire);
+    if (target) {
+        target->dispatch(std::forward<F>(job), nullptr);
     } else {
-        std::unique_lock<std::mutex> lock(mutex_);
-        tasks_.push(std::move(task));
-        if (!is_running_) {
-            is_running_ = true;
-            submit_next();
+        ThreadPool::instance().enqueue(std::forward<F>(job), qos_);
+    }
+}
+
+template <typename F>
+void Queue::dispatch(F&& task, Group* group, bool counted) {
+    if (type_ == Type::Concurrent) {
+        // Fast path: while no barrier is pending a read is one fetch_add away from
+        // the pool. Queues without barriers skip the shared count altogether.
+        if (barriers_ && (reads_.fetch_add(1, std::memory_order_acq_rel) & kBarrierPending)) {
+            std::lock_guard<std::mutex> lock(barrier_mutex_);
+            backlog_.push_back(Pending{Task(std::forward<F>(task)), group, false, counted});
+            reads_.fetch_sub(1, std::memory_order_acq_rel);
+            advance();
+            return;
         }
+        submit(make_read(std::forward<F>(task), group, counted));
+        return;
     }
+
+    Node* node = make_node(Job(std::forward<F>(task)), group, counted);
+    push(node, node);
 }
 
-void Queue::async_at(std::chrono::steady_clock::time_point when, Task task) {
-    Timer::instance().schedule(std::move(task), when, *this);
+void Queue::async(Task task) {
+    bool counted = capacity_.load(std::memory_order_acquire) > 0;
+    if (counted && overflow_.load(std::memory_order_relaxed) == ThreadPool::Overflow::DropOldest) {
+        hold(std::move(task), nullptr, true);
+        return;
+    }
+    if (counted && !admit(true))
+        return;
+    dispatch(std::move(task), nullptr, counted);
 }
 
-void Queue::async_after(std::chrono::milliseconds delay, Task task) {
-    auto when = std::chrono::steady_clock::now() + delay;
-    Timer::instance().schedule(std::move(task), when, *this);
+void Queue::async(Group& group, Task task) {
+    bool counted = capacity_.load(std::memory_order_acquire) > 0;
+    if (counted && overflow_.load(std::memory_order_relaxed) == ThreadPool::Overflow::DropOldest) {
+        group.enter();
+        hold(std::move(task), &group, true);
+        return;
+    }
+    if (counted && !admit(true))
+        return;
+    group.enter();
+    dispatch(std::move(task), &group, counted);
 }
 
-void Queue::sync(Task task) {
-    if (type_ == Type::Concurrent) {
-        std::mutex m;
-        std::condition_variable cv;
-        bool done = false;
+bool Queue::try_async(Task task) {
+    bool counted = capacity_.load(std::memory_order_acquire) > 0;
+    if (counted && overflow_.load(std::memory_order_relaxed) == ThreadPool::Overflow::DropOldest)
+        return hold(std::move(task), nullptr, false);
+    if (counted && !admit(false))
+        return false;
+    dispatch(std::move(task), nullptr, counted);
+    return true;
+}
+
+void Queue::set_capacity(size_t capacity, ThreadPool::Overflow overflow) {
+    // Publish the policy before the capacity that makes submitters read it.
+    overflow_.store(overflow, std::memory_order_relaxed);
+    capacity_.store(capacity, std::memory_order_release);
+}
+
+bool Queue::admit(bool wait) {
+    const size_t capacity = capacity_.load(std::memory_order_acquire);
+    if (reserve(capacity))
+        return true;
+
+    if (!wait || overflow_.load(std::memory_order_relaxed) == ThreadPool::Overflow::DropNewest) {
+        rejected_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    ThreadPool::BlockingScope blocking;
+    while (true) {
+        auto key = space_.prepare_wait();
+        if (reserve(capacity)) {
+            space_.cancel_wait();
+            return true;
+        }
+        space_.wait(key);
+    }
+}
+
+bool Queue::reserve(size_t capacity) {
+    size_t depth = depth_.load(std::memory_order_seq_cst);
+    while (depth < capacity) {
+        if (depth_.compare_exchange_weak(depth, depth + 1, std::memory_order_seq_cst))
+            return true;
+    }
+    return false;
+}
+
+void Queue::release() {
+    depth_.fetch_sub(1, std::memory_order_seq_cst);
+    space_.notify(1);
+}
+
+bool Queue::hold(Task task, Group* group, bool displace) {
+    std::unique_lock<std::mutex> lock(waiting_mutex_);
+    if (reserve(capacity_.load(std::memory_order_acquire))) {
+        waiting_.push_back(Pending{std::move(task), group, false, true});
+        lock.unlock();
+        // One run per held task; each run takes the oldest one still waiting.
+        dispatch([this] { run_oldest(); }, nullptr);
+        return true;
+    }
+
+    rejected_.fetch_add(1, std::memory_order_relaxed);
+    Pending dropped{std::move(task), group, false, true};
+    bool admitted = displace && !waiting_.empty();
+    if (admitted) {
+        // The new task takes the slot and the run of the oldest waiting one.
+        Pending oldest = std::move(waiting_.front());
+        waiting_.pop_front();
+        waiting_.push_back(std::move(dropped));
+        dropped = std::move(oldest);
+    }
+    lock.unlock();
+
+    dropped.task = nullptr;
+    if (dropped.group)
+        dropped.group->leave();
+    return admitted;
+}
+
+void Queue::run_oldest() {
+    std::unique_lock<std::mutex> lock(waiting_mutex_);
+    Pending pending = std::move(waiting_.front());
+    waiting_.pop_front();
+    lock.unlock();
+
+    struct Finish {
+        Queue* queue;
+        Group* group;
+        ~Finish() {
+            if (group)
+                group->leave();
+            queue->release();
+        }
+    } finish{this, pending.group};
+    pending.task();
+}
 
-        ThreadPool::instance().submit([&]{
+void Queue::async_barrier(Task task) {
+    if (type_ == Type::Serial || !barriers_) {
+        dispatch(std::move(task), nullptr);
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(barrier_mutex_);
+    reads_.fetch_or(kBarrierPending, std::memory_order_acq_rel);
+    backlog_.push_back(Pending{std::move(task), nullptr, true, false});
+    advance();
+}
+
+void Queue::dispatch_batch(Task* tasks, size_t count) {
+    if (count == 0)
+        return;
+
+    if (barriers_ && (reads_.fetch_add(count, std::memory_order_acq_rel) & kBarrierPending)) {
+        std::lock_guard<std::mutex> lock(barrier_mutex_);
+        for (size_t i = 0; i < count; i++) {
+            backlog_.push_back(Pending{std::move(tasks[i]), nullptr, false, false});
+        }
+        reads_.fetch_sub(count, std::memory_order_acq_rel);
+        advance();
+        return;
+    }
+
+    if (target_.load(std::memory_order_acquire)) {
+        for (size_t i = 0; i < count; i++) {
+            submit(make_read(std::move(tasks[i]), nullptr));
+        }
+        return;
+    }
+
+    // Reused across calls so that steady batching, such as the timer's, does not allocate.
+    static thread_local std::vector<Job> jobs;
+    jobs.clear();
+    for (size_t i = 0; i < count; i++) {
+        jobs.push_back(make_read(std::move(tasks[i]), nullptr));
+    }
+    ThreadPool::instance().enqueue_bulk(jobs, qos_);
+}
+
+void Queue::finish_read() {
+    size_t reads = reads_.load(std::memory_order_relaxed);
+    while (true) {
+        // The last read before a pending barrier keeps its count until the
+        // lock is held, so the barrier cannot start and the queue cannot be
+        // destroyed while this thread still uses it.
+        if (reads == (kBarrierPending | 1)) {
+            std::lock_guard<std::mutex> lock(barrier_mutex_);
+            reads_.fetch_sub(1, std::memory_order_acq_rel);
+            advance();
+            return;
+        }
+        if (reads_.compare_exchange_weak(reads, reads - 1, std::memory_order_seq_cst,
+                                         std::memory_order_relaxed)) {
+            if (reads == 1)
+                detail::notify_teardown();
+            return;
+        }
+    }
+}
+
+void Queue::finish_barrier() {
+    std::lock_guard<std::mutex> lock(barrier_mutex_);
+    barrier_running_ = false;
+    advance();
+}
+
+void Queue::advance() {
+    while (!barrier_running_ && !backlog_.empty()) {
+        Pending& front = backlog_.front();
+        if (!front.barrier) {
+            reads_.fetch_add(1, std::memory_order_acq_rel);
+            submit(make_read(std::move(front.task), front.group, front.counted));
+            backlog_.pop_front();
+            continue;
+        }
+
+        if ((reads_.load(std::memory_order_acquire) & ~kBarrierPending) != 0)
+            return;
+
+        barrier_running_ = true;
+        submit([this, task = std::move(front.task)]() mutable {
+            struct Finish {
+                Queue* queue;
+                ~Finish() {
+                    detail::record(queue->counters_, 1);
+                    queue->finish_barrier();
+                }
+            } finish{this};
             task();
-            {
-                std::lock_guard<std::mutex> lock(m);
-                done = true;
-            }
-            cv.notify_one();
-        }, qos_);
+        });
+        backlog_.pop_front();
+    }
+
+    if (!barrier_running_ && backlog_.empty()) {
+        if (reads_.fetch_and(~kBarrierPending, std::memory_order_seq_cst) == kBarrierPending)
+            detail::notify_teardown();
+    }
+}
+
+Timer::Handle Queue::async_at(std::chrono::steady_clock::time_point when, Task task,
+                              std::chrono::milliseconds leeway) {
+    return Timer::instance().schedule(std::move(task), when, *this, leeway);
+}
+
+Timer::Handle Queue::async_after(std::chrono::milliseconds delay, Task task,
+                                 std::chrono::milliseconds leeway) {
+    auto when = std::chrono::steady_clock::now() + delay;
+    return Timer::instance().schedule(std::move(task), when, *this, leeway);
+}
+
+Timer::Handle Queue::async_every(std::chrono::milliseconds period, Task task,
+                                 Timer::Missed missed, std::chrono::milliseconds leeway) {
+    auto first = std::chrono::steady_clock::now() + period;
+    return Timer::instance().schedule_every(std::move(task), first, period, *this, missed, leeway);
+}
 
-        std::unique_lock<std::mutex> lock(m);
-        cv.wait(lock, [&]{ return done; });
+void Queue::sync(Task task) {
+    if (type_ == Type::Concurrent) {
+        wait_for(std::move(task), false);
     } else {
         if (std::this_thread::get_id() == running_thread_id_) {
             assert(false && "Queue::sync called recursively on the same serial queue!");
@@ -93,25 +380,369 @@ void Queue::sync(Task task) {
     }
 }
 
-void Queue::submit_next() {
-    if (tasks_.empty()) {
-        is_running_ = false;
+void Queue::sync_barrier(Task task) {
+    if (type_ == Type::Serial) {
+        sync(std::move(task));
         return;
     }
+    wait_for(std::move(task), true);
+}
 
-    auto task = std::move(tasks_.front());
-    tasks_.pop();
+void Queue::wait_for(Task task, bool barrier) {
+    std::mutex m;
+    std::condition_variable cv;
+    bool done = false;
 
-    ThreadPool::instance().submit([this, task = std::move(task)]() mutable {
-        running_thread_id_ = std::this_thread::get_id();
-        try {
-            task();
-        } catch (...) {
-            std::cerr << "Queue[" << name_ << "] exception\n";
+    Task job = [&] {
+        struct Done {
+            std::mutex& m;
+            std::condition_variable& cv;
+            bool& done;
+            ~Done() {
+                std::lock_guard<std::mutex> lock(m);
+                done = true;
+                cv.notify_one();
+            }
+        } signal{m, cv, done};
+        task();
+    };
+
+    // Bypasses the capacity, so the task the caller waits for is never dropped.
+    if (barrier) {
+        async_barrier(std::move(job));
+    } else {
+        dispatch(std::move(job), nullptr);
+    }
+
+    ThreadPool::BlockingScope blocking;
+    std::unique_lock<std::mutex> lock(m);
+    cv.wait(lock, [&]{ return done; });
+}
+
+/**
+ * @brief Free MPSC nodes shared by all threads.
+ *
+ * Drains return the nodes they used in one chain per pass, and producers
+ * take the whole list into their NodeCache once theirs runs dry, so nodes
+ * flow back to whichever thread posts, including the timer and reactor
+ * threads. Only pushes use CAS and takers swap out the entire list, so the
+ * stack has no ABA problem.
+ */
+struct Queue::NodePool {
+    static constexpr size_t kCapacity = 16384;
+
+    std::atomic<Node*> head{nullptr};
+    std::atomic<size_t> size{0};
+};
+
+/**
+ * @brief Per-thread list of free MPSC nodes, refilled from the NodePool.
+ */
+struct Queue::NodeCache {
+    Node* head = nullptr;
+
+    ~NodeCache() {
+        while (head) {
+            Node* next = head->next.load(std::memory_order_relaxed);
+            delete head;
+            head = next;
         }
-        running_thread_id_ = std::thread::id{};
-        submit_next();
-    }, qos_);
+    }
+};
+
+Queue::NodePool& Queue::node_pool() {
+    // Never destroyed: drains on pool threads may still return nodes during exit.
+    static NodePool* pool = new NodePool;
+    return *pool;
+}
+
+Queue::NodeCache& Queue::node_cache() {
+    static thread_local NodeCache cache;
+    return cache;
+}
+
+Queue::Node* Queue::make_node(Job task, Group* group, bool counted) {
+    auto& cache = node_cache();
+
+    if (!cache.head) {
+        auto& pool = node_pool();
+        cache.head = pool.head.exchange(nullptr, std::memory_order_acquire);
+        size_t taken = 0;
+        for (Node* node = cache.head; node; node = node->next.load(std::memory_order_relaxed)) {
+            taken++;
+        }
+        pool.size.fetch_sub(taken, std::memory_order_relaxed);
+    }
+
+    Node* node = cache.head;
+    if (!node) {
+        node = new Node;
+    } else {
+        cache.head = node->next.load(std::memory_order_relaxed);
+    }
+    node->next.store(nullptr, std::memory_order_relaxed);
+    node->task = std::move(task);
+    node->group = group;
+    node->counted = counted;
+    return node;
+}
+
+void Queue::free_nodes(Node* first, Node* last, size_t count) {
+    auto& pool = node_pool();
+
+    if (pool.size.load(std::memory_order_relaxed) + count > NodePool::kCapacity) {
+        while (first) {
+            Node* next = first->next.load(std::memory_order_relaxed);
+            delete first;
+            first = next;
+        }
+        return;
+    }
+
+    pool.size.fetch_add(count, std::memory_order_relaxed);
+    Node* head = pool.head.load(std::memory_order_relaxed);
+    do {
+        last->next.store(head, std::memory_order_relaxed);
+    } while (!pool.head.compare_exchange_weak(head, first, std::memory_order_release,
+                                              std::memory_order_relaxed));
+}
+
+void Queue::push(Node* first, Node* last) {
+    last->next.store(nullptr, std::memory_order_relaxed);
+    Node* prev = head_.exchange(last, std::memory_order_acq_rel);
+    prev->next.store(first, std::memory_order_release);
+
+    if (!scheduled_.exchange(true)) {
+        schedule_drain();
+    }
+}
+
+Queue::Node* Queue::pop() {
+    Node* tail = tail_;
+    Node* next = tail->next.load(std::memory_order_acquire);
+
+    if (tail == &stub_) {
+        if (!next)
+            return nullptr;
+        tail_ = next;
+        tail = next;
+        next = next->next.load(std::memory_order_acquire);
+    }
+
+    if (next) {
+        tail_ = next;
+        return tail;
+    }
+
+    // A producer may have swapped head_ but not linked its node yet.
+    if (tail != head_.load(std::memory_order_acquire))
+        return nullptr;
+
+    stub_.next.store(nullptr, std::memory_order_relaxed);
+    Node* prev = head_.exchange(&stub_, std::memory_order_acq_rel);
+    prev->next.store(&stub_, std::memory_order_release);
+
+    next = tail->next.load(std::memory_order_acquire);
+    if (next) {
+        tail_ = next;
+        return tail;
+    }
+    return nullptr;
+}
+
+bool Queue::empty() const {
+    return tail_ == &stub_ && head_.load() == &stub_;
+}
+
+void Queue::schedule_drain() {
+    submit([this] { drain(); });
+}
+
+namespace {
+
+/**
+ * @brief Shared progress of one Queue::apply() call.
+ *
+ * Helpers that start after all indices are claimed find nothing to do and
+ * never touch the caller's callable, so the caller only waits for claimed work.
+ */
+struct ApplyState {
+    size_t count;
+    size_t participants;
+    void (*invoke)(void*, size_t, size_t);
+    void* context;
+
+    std::atomic<size_t> next{0};
+    std::atomic<size_t> done{0};
+
+    std::mutex mutex;
+    std::condition_variable cv;
+    bool finished = false;
+    std::exception_ptr exception;
+
+    // Guided self-scheduling: claim a share of what is left, never less than one index.
+    void run() {
+        while (true) {
+            size_t start = next.load(std::memory_order_relaxed);
+            if (start >= count)
+                return;
+
+            size_t chunk = std::max<size_t>(1, (count - start) / (2 * participants));
+            start = next.fetch_add(chunk, std::memory_order_relaxed);
+            if (start >= count)
+                return;
+            size_t end = std::min(count, start + chunk);
+
+            try {
+                invoke(context, start, end);
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(mutex);
+                if (!exception)
+                    exception = std::current_exception();
+            }
+
+            if (done.fetch_add(end - start, std::memory_order_acq_rel) + (end - start) == count) {
+                std::lock_guard<std::mutex> lock(mutex);
+                finished = true;
+                cv.notify_one();
+            }
+        }
+    }
+};
+
+} // namespace
+
+void Queue::apply_range(size_t n, void (*invoke)(void*, size_t, size_t), void* context) {
+    if (n == 0)
+        return;
+
+    auto& pool = ThreadPool::instance();
+    size_t helpers = std::min(pool.size(), n - 1);
+
+    if (type_ == Type::Serial || helpers == 0) {
+        invoke(context, 0, n);
+        return;
+    }
+
+    auto state = std::make_shared<ApplyState>();
+    state->count = n;
+    state->participants = helpers + 1;
+    state->invoke = invoke;
+    state->context = context;
+
+    // Helpers go through the queue like ordinary tasks, so they wait behind a
+    // pending barrier. The caller works through every index on its own if none
+    // gets to start, so they need no slot of the queue's capacity.
+    for (size_t i = 0; i < helpers; i++) {
+        dispatch([state] { state->run(); }, nullptr);
+    }
+    state->run();
+
+    {
+        std::unique_lock<std::mutex> lock(state->mutex);
+        state->cv.wait(lock, [&] { return state->finished; });
+    }
+
+    if (state->exception)
+        std::rethrow_exception(state->exception);
+}
+
+void Queue::set_quantum(Quantum quantum) {
+    quantum_tasks_.store(quantum.max_tasks > 0 ? quantum.max_tasks : 1, std::memory_order_relaxed);
+    quantum_time_.store(quantum.max_time.count(), std::memory_order_relaxed);
+}
+
+void Queue::set_target(Queue& target) {
+    for (Queue* queue = &target; queue; queue = queue->target_.load(std::memory_order_acquire)) {
+        assert(queue != this && "Queue::set_target would create a cycle");
+    }
+    target_.store(&target, std::memory_order_release);
+}
+
+void Queue::reset_target() {
+    target_.store(nullptr, std::memory_order_release);
+}
+
+void Queue::drain() {
+    active_drains_.fetch_add(1, std::memory_order_relaxed);
+    drain_tasks();
+    if (active_drains_.fetch_sub(1, std::memory_order_seq_cst) == 1)
+        detail::notify_teardown();
+}
+
+void Queue::drain_tasks() {
+    const size_t max_tasks = quantum_tasks_.load(std::memory_order_relaxed);
+    const auto deadline = std::chrono::steady_clock::now() +
+        std::chrono::microseconds(quantum_time_.load(std::memory_order_relaxed));
+
+    // Nodes of this pass go back to the NodePool as one chain on return.
+    struct Freed {
+        Node* first = nullptr;
+        Node* last = nullptr;
+        size_t count = 0;
+
+        void add(Node* node) {
+            node->task = nullptr;
+            node->next.store(first, std::memory_order_relaxed);
+            if (!last)
+                last = node;
+            first = node;
+            count++;
+        }
+        ~Freed() {
+            if (first)
+                free_nodes(first, last, count);
+        }
+    } freed;
+
+    size_t executed = 0;
+    size_t recorded = 0;
+    uint64_t since = detail::task_start_ns;
+    while (true) {
+        if (executed > 0 && !empty() &&
+            (executed >= max_tasks || std::chrono::steady_clock::now() >= deadline)) {
+            // Quantum used up: give the worker back and continue on a later visit.
+            detail::record(counters_, executed - recorded, since);
+            schedule_drain();
+            return;
+        }
+
+        Node* node = pop();
+        if (!node) {
+            if (!empty()) {
+                // A producer is between its two steps of push(); it finishes promptly.
+                std::this_thread::yield();
+                continue;
+            }
+
+            // Release the queue, then re-check for a push that raced with the release.
+            since = detail::record(counters_, executed - recorded, since);
+            recorded = executed;
+            // From here another drain may own tail_; only head_ is safe to read.
+            scheduled_.store(false);
+            if (head_.load() == &stub_ || scheduled_.exchange(true))
+                return;
+            continue;
+        }
+
+        execute(node->task);
+        executed++;
+        if (node->group)
+            node->group->leave();
+        if (node->counted)
+            release();
+        freed.add(node);
+    }
+}
+
+void Queue::execute(Job& task) {
+    running_thread_id_ = std::this_thread::get_id();
+    try {
+        task();
+    } catch (...) {
+        std::cerr << "Queue[" << name_ << "] exception\n";
+    }
+    running_thread_id_ = std::thread::id{};
 }
 
 }
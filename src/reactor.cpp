@@ -0,0 +1,260 @@
+/*
+ * Copyright 2025 Denis Silko
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <TurboQ/reactor.hpp>
+#include <TurboQ/queue.hpp>
+
+#if defined(__linux__)
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+#include <cerrno>
+#endif
+
+namespace turboq {
+
+/**
+ * @brief State of one watched descriptor, shared with the handler runs in flight.
+ */
+struct Reactor::Registration {
+    int fd;
+    Queue* queue;
+    Handler handler;
+
+    // Events not yet handed to the handler.
+    std::atomic<uint32_t> events{0};
+    // A handler run is queued or running.
+    std::atomic<bool> scheduled{false};
+    std::atomic<bool> cancelled{false};
+
+    Registration(int f, Queue* q, Handler h) : fd(f), queue(q), handler(std::move(h)) {}
+};
+
+Reactor& Reactor::instance() {
+    static Reactor reactor;
+    return reactor;
+}
+
+bool Reactor::Handle::cancel() {
+    auto link = reactor_.lock();
+    if (!registration_ || !link)
+        return false;
+
+    std::lock_guard<std::mutex> guard(link->mutex);
+    return link->reactor && link->reactor->remove(registration_);
+}
+
+bool Reactor::Handle::active() const {
+    return registration_ && !registration_->cancelled.load(std::memory_order_acquire);
+}
+
+#if defined(__linux__)
+
+namespace {
+
+uint32_t from_epoll(uint32_t flags) {
+    uint32_t events = 0;
+    if (flags & (EPOLLIN | EPOLLPRI | EPOLLRDHUP))
+        events |= Reactor::Read;
+    if (flags & EPOLLOUT)
+        events |= Reactor::Write;
+    if (flags & (EPOLLHUP | EPOLLRDHUP))
+        events |= Reactor::Hangup;
+    if (flags & EPOLLERR)
+        events |= Reactor::Error;
+    return events;
+}
+
+} // namespace
+
+bool Reactor::supported() {
+    return true;
+}
+
+Reactor::Reactor()
+    : epoll_fd_(epoll_create1(EPOLL_CLOEXEC)),
+      wake_fd_(eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC)),
+      stop_(false),
+      link_(std::make_shared<Link>(this)) {
+    if (epoll_fd_ >= 0 && wake_fd_ >= 0) {
+        epoll_event event{};
+        event.events = EPOLLIN;
+        event.data.ptr = nullptr;
+        epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, wake_fd_, &event);
+        worker_ = std::thread([this] { run(); });
+    }
+}
+
+Reactor::~Reactor() {
+    {
+        // Wait for handles in cancel() and keep later ones out.
+        std::lock_guard<std::mutex> guard(link_->mutex);
+        link_->reactor = nullptr;
+    }
+    stop_.store(true, std::memory_order_release);
+    if (wake_fd_ >= 0) {
+        uint64_t one = 1;
+        [[maybe_unused]] auto written = ::write(wake_fd_, &one, sizeof(one));
+    }
+    if (worker_.joinable())
+        worker_.join();
+
+    for (auto& [key, registration] : registrations_) {
+        registration->cancelled.store(true, std::memory_order_release);
+    }
+    if (wake_fd_ >= 0)
+        ::close(wake_fd_);
+    if (epoll_fd_ >= 0)
+        ::close(epoll_fd_);
+}
+
+Reactor::Handle Reactor::watch(int fd, uint32_t events, Queue& queue, Handler handler) {
+    if (epoll_fd_ < 0)
+        return Handle();
+
+    auto registration = std::make_shared<Registration>(fd, &queue, std::move(handler));
+
+    epoll_event event{};
+    // A half-closed peer only matters to readers; EPOLLHUP and EPOLLERR are
+    // reported to every registration.
+    event.events = EPOLLET;
+    if (events & Read)
+        event.events |= EPOLLIN | EPOLLRDHUP;
+    if (events & Write)
+        event.events |= EPOLLOUT;
+    event.data.ptr = registration.get();
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, fd, &event) != 0)
+        return Handle();
+    registrations_.emplace(registration.get(), registration);
+    return Handle(link_, std::move(registration));
+}
+
+bool Reactor::remove(const std::shared_ptr<Registration>& registration) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (registration->cancelled.exchange(true, std::memory_order_acq_rel))
+        return false;
+
+    epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, registration->fd, nullptr);
+    auto it = registrations_.find(registration.get());
+    if (it != registrations_.end()) {
+        retired_.push_back(std::move(it->second));
+        registrations_.erase(it);
+    }
+    return true;
+}
+
+void Reactor::run() {
+    constexpr int kMaxEvents = 64;
+    epoll_event events[kMaxEvents];
+    std::vector<std::shared_ptr<Registration>> retired;
+    std::vector<std::shared_ptr<Registration>> ready;
+    ready.reserve(kMaxEvents);
+
+    while (!stop_.load(std::memory_order_acquire)) {
+        int count = epoll_wait(epoll_fd_, events, kMaxEvents, -1);
+        if (count < 0) {
+            if (errno == EINTR)
+                continue;
+            break;
+        }
+
+        {
+            // Registrations removed before this point are still alive in retired_.
+            std::lock_guard<std::mutex> lock(mutex_);
+            for (int i = 0; i < count; i++) {
+                auto* registration = static_cast<Registration*>(events[i].data.ptr);
+                if (!registration) {
+                    uint64_t value;
+                    [[maybe_unused]] auto drained = ::read(wake_fd_, &value, sizeof(value));
+                    continue;
+                }
+                if (registration->cancelled.load(std::memory_order_acquire))
+                    continue;
+                auto it = registrations_.find(registration);
+                if (it != registrations_.end() && claim(*registration, from_epoll(events[i].events)))
+                    ready.push_back(it->second);
+            }
+            // Nothing from this batch refers to them any more.
+            retired.swap(retired_);
+        }
+        retired.clear();
+
+        // Outside the lock: submitting may wait on the queue, and handlers
+        // may call watch() or cancel().
+        for (auto& registration : ready) {
+            deliver(registration);
+        }
+        ready.clear();
+    }
+}
+
+#else
+
+bool Reactor::supported() {
+    return false;
+}
+
+Reactor::Reactor() : epoll_fd_(-1), wake_fd_(-1), stop_(false), link_(std::make_shared<Link>(this)) {}
+
+Reactor::~Reactor() {
+    std::lock_guard<std::mutex> guard(link_->mutex);
+    link_->reactor = nullptr;
+}
+
+Reactor::Handle Reactor::watch(int, uint32_t, Queue&, Handler) {
+    return Handle();
+}
+
+bool Reactor::remove(const std::shared_ptr<Registration>& registration) {
+    return !registration->cancelled.exchange(true, std::memory_order_acq_rel);
+}
+
+void Reactor::run() {}
+
+#endif
+
+bool Reactor::claim(Registration& registration, uint32_t events) {
+    registration.events.fetch_or(events, std::memory_order_seq_cst);
+    return !registration.scheduled.load(std::memory_order_seq_cst) &&
+           !registration.scheduled.exchange(true);
+}
+
+void Reactor::deliver(const std::shared_ptr<Registration>& registration) {
+    registration->queue->enqueue([registration] { fire(registration); });
+}
+
+void Reactor::fire(const std::shared_ptr<Registration>& registration) {
+    struct Finish {
+        const std::shared_ptr<Registration>& registration;
+        ~Finish() {
+            // Readiness that arrived while the handler ran saw scheduled set; pick it up here.
+            registration->scheduled.store(false, std::memory_order_seq_cst);
+            if (registration->events.load(std::memory_order_seq_cst) != 0 &&
+                !registration->cancelled.load(std::memory_order_acquire) &&
+                !registration->scheduled.exchange(true)) {
+                deliver(registration);
+            }
+        }
+    } finish{registration};
+
+    uint32_t events = registration->events.exchange(0, std::memory_order_seq_cst);
+    if (events != 0 && !registration->cancelled.load(std::memory_order_acquire))
+        registration->handler(events);
+}
+
+} // namespace turboq
@@ -0,0 +1,80 @@
+/*
+ * Copyright 2025 Denis Silko
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <TurboQ/source.hpp>
+#include <TurboQ/queue.hpp>
+#include <TurboQ/detail/teardown.hpp>
+
+namespace turboq {
+
+Source::Source(Queue& queue, Merge merge, Handler handler)
+    : queue_(queue), merge_(merge), handler_(std::move(handler)),
+      data_(0), scheduled_(false), active_(0), cancelled_(false) {}
+
+Source::~Source() {
+    cancel();
+    // A queued run still calls fire(), which notifies once it is done with the source.
+    detail::wait_for_teardown([this] {
+        return !scheduled_.load(std::memory_order_seq_cst) &&
+               active_.load(std::memory_order_seq_cst) == 0;
+    });
+}
+
+void Source::merge(uint64_t data) {
+    if (data == 0 || cancelled_.load(std::memory_order_relaxed))
+        return;
+
+    switch (merge_) {
+        case Merge::Add:     data_.fetch_add(data, std::memory_order_seq_cst); break;
+        case Merge::Or:      data_.fetch_or(data, std::memory_order_seq_cst); break;
+        case Merge::Replace: data_.exchange(data, std::memory_order_seq_cst); break;
+    }
+
+    // While a run is queued or running, it (or the run it schedules on exit) picks the data up.
+    if (!scheduled_.load(std::memory_order_seq_cst) && !scheduled_.exchange(true)) {
+        queue_.enqueue([this] { fire(); });
+    }
+}
+
+void Source::cancel() {
+    cancelled_.store(true, std::memory_order_release);
+}
+
+void Source::fire() {
+    active_.fetch_add(1, std::memory_order_relaxed);
+
+    struct Finish {
+        Source* source;
+        ~Finish() {
+            // Data merged while the handler ran saw scheduled_ set, so look for it
+            // here. Runs even if the handler threw.
+            source->scheduled_.store(false, std::memory_order_seq_cst);
+            if (source->data_.load(std::memory_order_seq_cst) != 0 &&
+                !source->cancelled_.load(std::memory_order_acquire) &&
+                !source->scheduled_.exchange(true)) {
+                source->queue_.enqueue([source = source] { source->fire(); });
+            }
+            if (source->active_.fetch_sub(1, std::memory_order_seq_cst) == 1)
+                detail::notify_teardown();
+        }
+    } finish{this};
+
+    uint64_t data = data_.exchange(0, std::memory_order_seq_cst);
+    if (data != 0 && !cancelled_.load(std::memory_order_acquire))
+        handler_(data);
+}
+
+} // namespace turboq
@@ -15,66 +15,793 @@
  */
 
 #include <TurboQ/thread_pool.hpp>
+#include <TurboQ/detail/topology.hpp>
+
+#include <algorithm>
 
 namespace turboq {
 
+namespace detail {
+
+namespace {
+
+struct QueueRegistry {
+    std::mutex mutex;
+    QueueCounters* head = nullptr;
+};
+
+QueueRegistry& queue_registry() {
+    static QueueRegistry registry;
+    return registry;
+}
+
+} // namespace
+
+QueueCounters::QueueCounters(std::string name) : name(std::move(name)) {
+    auto& registry = queue_registry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    next = registry.head;
+    if (next)
+        next->prev = this;
+    registry.head = this;
+}
+
+QueueCounters::~QueueCounters() {
+    auto& registry = queue_registry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    if (prev)
+        prev->next = next;
+    else
+        registry.head = next;
+    if (next)
+        next->prev = prev;
+}
+
+} // namespace detail
+
+namespace {
+
+struct WorkerContext {
+    ThreadPool* pool = nullptr;
+    size_t index = 0;
+    // Policy::Fair virtual time of the worker and the next start time per level.
+    uint64_t vtime = 0;
+    uint64_t pass[4] = {};
+};
+
+constexpr size_t kInteractive = static_cast<size_t>(ThreadPool::QoS::UserInteractive);
+constexpr uint64_t kStrideBase = uint64_t(1) << 20;
+
+thread_local WorkerContext current_worker;
+
+ThreadPool::Options with_threads(size_t threads) {
+    ThreadPool::Options options;
+    options.threads = threads;
+    return options;
+}
+
+} // namespace
+
 ThreadPool& ThreadPool::instance(size_t threads) {
-    static ThreadPool pool(threads);
+    return instance(with_threads(threads));
+}
+
+ThreadPool& ThreadPool::instance(const Options& options) {
+    static ThreadPool pool(options);
     return pool;
 }
 
-ThreadPool::ThreadPool(size_t threads) : stop_(false) {
+ThreadPool::ThreadPool(size_t threads)
+    : ThreadPool(with_threads(threads)) {}
+
+ThreadPool::ThreadPool(const Options& options)
+    : scheduler_(options.scheduler), policy_(options.policy),
+      reserved_(std::min(options.reserved_interactive, options.threads > 0 ? options.threads - 1 : 0)),
+      metrics_(options.metrics),
+      stop_(false), spin_count_(options.spin_count), yield_count_(options.yield_count),
+      // At least one worker always runs; external submissions are spread over the core ones.
+      slots_(std::max({size_t{1}, options.threads, options.max_threads})),
+      min_threads_(std::max<size_t>(1, options.threads)),
+      live_(0), blocked_(0), spawn_after_(options.spawn_after), idle_timeout_(options.idle_timeout),
+      nodes_(1), spinning_(0), next_queue_(0),
+      capacity_(options.capacity), overflow_(options.overflow) {
+    for (size_t level = 0; level < kQoSLevels; level++) {
+        pending_[level].store(0, std::memory_order_relaxed);
+        rejected_[level].store(0, std::memory_order_relaxed);
+    }
+
+    for (size_t level = 0; level < kQoSLevels; level++) {
+        strides_[level] = kStrideBase / std::max(1u, options.weights[level]);
+    }
+
+    place_workers(options);
+
+    if (scheduler_ == Scheduler::WorkStealing) {
+        for (size_t i = 0; i < slots_.size(); i++) {
+            local_queues_.push_back(std::make_unique<WorkerQueue>());
+        }
+    } else {
+        for (size_t level = 0; level < nodes_ * kQoSLevels; level++) {
+            levels_.push_back(std::make_unique<Level>(options.ring_capacity));
+        }
+    }
+
+    for (size_t i = 0; i < slots_.size(); i++) {
+        worker_stats_.push_back(std::make_unique<WorkerStats>());
+    }
+
+    std::lock_guard<std::mutex> lock(slots_mutex_);
+    for (size_t i = 0; i < min_threads_; i++) {
+        start_worker(i);
+    }
+    if (elastic()) {
+        supervisor_ = std::thread([this] { supervise(); });
+    }
+}
+
+void ThreadPool::place_workers(const Options& options) {
+    const size_t threads = slots_.size();
+    std::vector<std::vector<int>> nodes;
+
+    if (options.numa || options.affinity != Affinity::None) {
+        for (auto& cpus : detail::detect_topology().nodes) {
+            if (!options.cpus.empty()) {
+                cpus.erase(std::remove_if(cpus.begin(), cpus.end(), [&](int cpu) {
+                    return std::find(options.cpus.begin(), options.cpus.end(), cpu) == options.cpus.end();
+                }), cpus.end());
+            }
+            if (!cpus.empty())
+                nodes.push_back(std::move(cpus));
+        }
+        // Requested CPUs the process cannot see still form a usable set.
+        if (nodes.empty() && !options.cpus.empty())
+            nodes.push_back(options.cpus);
+
+        if (!options.numa && nodes.size() > 1) {
+            std::vector<int> all;
+            for (auto& cpus : nodes) {
+                all.insert(all.end(), cpus.begin(), cpus.end());
+            }
+            std::sort(all.begin(), all.end());
+            nodes.assign(1, std::move(all));
+        }
+    }
+
+    nodes_ = std::max<size_t>(1, std::min(nodes.size(), std::max<size_t>(1, min_threads_)));
+    node_workers_.assign(nodes_, {});
+    worker_node_.resize(threads);
+
+    // Interleave workers over nodes so that small pools still span all of them.
     for (size_t i = 0; i < threads; i++) {
-        workers_.emplace_back([this] { this->worker_loop(); });
+        size_t node = i % nodes_;
+        worker_node_[i] = node;
+        // External submissions only target workers that never exit and run every level.
+        if (i >= reserved_ && i < min_threads_)
+            node_workers_[node].push_back(i);
+
+        if (nodes.empty() || options.affinity == Affinity::None)
+            continue;
+        const auto& cpus = nodes[node];
+        if (options.affinity == Affinity::Core) {
+            slots_[i].cpus = {cpus[(i / nodes_) % cpus.size()]};
+        } else {
+            slots_[i].cpus = cpus;
+        }
+    }
+
+    if (nodes_ > 1) {
+        for (size_t node = 0; node < nodes_; node++) {
+            for (int cpu : nodes[node]) {
+                if (cpu >= static_cast<int>(cpu_node_.size()))
+                    cpu_node_.resize(cpu + 1, -1);
+                cpu_node_[cpu] = static_cast<int>(node);
+            }
+        }
+    }
+
+    steal_order_.resize(threads);
+    steal_local_.resize(threads);
+    for (size_t i = 0; i < threads; i++) {
+        auto& order = steal_order_[i];
+        for (size_t k = 0; k < threads; k++) {
+            size_t victim = (i + k) % threads;
+            if (worker_node_[victim] == worker_node_[i])
+                order.push_back(victim);
+        }
+        steal_local_[i] = order.size();
+        for (size_t k = 0; k < threads; k++) {
+            size_t victim = (i + k) % threads;
+            if (worker_node_[victim] != worker_node_[i])
+                order.push_back(victim);
+        }
     }
 }
 
 ThreadPool::~ThreadPool() {
     {
-        std::unique_lock<std::mutex> lock(mutex_);
-        stop_ = true;
-        cv_.notify_all();
+        std::lock_guard<std::mutex> lock(slots_mutex_);
+        stop_.store(true, std::memory_order_seq_cst);
     }
-    for (auto& t : workers_) {
-        if (t.joinable())
-            t.join();
+    parking_.notify_all();
+    reserved_parking_.notify_all();
+    for (auto& space : space_) {
+        space.notify_all();
+    }
+
+    if (supervisor_.joinable()) {
+        {
+            std::lock_guard<std::mutex> lock(supervisor_mutex_);
+        }
+        supervisor_cv_.notify_all();
+        supervisor_idle_.notify_all();
+        supervisor_.join();
+    }
+
+    // No worker starts once stop_ is set, so the slots are stable here.
+    for (auto& slot : slots_) {
+        if (slot.thread.joinable())
+            slot.thread.join();
     }
 }
 
-ThreadPool::PrioritizedTask::PrioritizedTask(Task t, QoS q)
-    : task(std::move(t)), qos(q) {}
+void ThreadPool::start_worker(size_t index) {
+    auto& slot = slots_[index];
+    if (slot.thread.joinable())
+        slot.thread.join();
+    slot.running = true;
+    live_.fetch_add(1, std::memory_order_relaxed);
+    slot.thread = std::thread([this, index, cpus = slot.cpus] {
+        if (!cpus.empty())
+            detail::pin_current_thread(cpus);
+        this->worker_loop(index);
+    });
+}
+
+bool ThreadPool::spawn_worker() {
+    std::lock_guard<std::mutex> lock(slots_mutex_);
+    if (stop_.load(std::memory_order_relaxed))
+        return false;
+    for (size_t i = min_threads_; i < slots_.size(); i++) {
+        if (!slots_[i].running) {
+            start_worker(i);
+            return true;
+        }
+    }
+    return false;
+}
+
+bool ThreadPool::retire_worker(size_t index) {
+    std::lock_guard<std::mutex> lock(slots_mutex_);
+    if (stop_.load(std::memory_order_relaxed))
+        return false;
+    slots_[index].running = false;
+    live_.fetch_sub(1, std::memory_order_relaxed);
+    return true;
+}
+
+void ThreadPool::supervise() {
+    const auto tick = std::max(std::chrono::milliseconds(1), std::min(spawn_after_ / 2, std::chrono::milliseconds(10)));
+    std::chrono::steady_clock::time_point saturated_since{};
+
+    std::unique_lock<std::mutex> lock(supervisor_mutex_);
+    while (!stop_.load(std::memory_order_acquire)) {
+        // Nothing queued: sleep until publish() reports work or the pool stops.
+        auto key = supervisor_idle_.prepare_wait();
+        if (!has_pending() && !stop_.load(std::memory_order_seq_cst)) {
+            lock.unlock();
+            supervisor_idle_.wait(key);
+            lock.lock();
+            saturated_since = {};
+            continue;
+        }
+        supervisor_idle_.cancel_wait();
+
+        // Work is queued: poll on the tick until it has drained.
+        supervisor_cv_.wait_for(lock, tick);
+
+        // Saturated: work is queued but no worker is polling or parked.
+        bool saturated = has_pending() &&
+                         spinning_.load(std::memory_order_relaxed) == 0 &&
+                         parking_.waiters() == 0;
+        if (!saturated) {
+            saturated_since = {};
+            continue;
+        }
+
+        auto now = std::chrono::steady_clock::now();
+        if (saturated_since == std::chrono::steady_clock::time_point{}) {
+            saturated_since = now;
+        } else if (now - saturated_since >= spawn_after_) {
+            spawn_worker();
+            saturated_since = now;
+        }
+    }
+}
+
+ThreadPool::BlockingScope::BlockingScope() : pool_(nullptr) {
+    ThreadPool* pool = current_worker.pool;
+    if (!pool || !pool->elastic())
+        return;
+
+    pool_ = pool;
+    size_t blocked = pool->blocked_.fetch_add(1, std::memory_order_relaxed) + 1;
+    size_t live = pool->live_.load(std::memory_order_relaxed);
+    if (live < blocked + pool->min_threads_) {
+        pool->spawn_worker();
+    }
+}
+
+ThreadPool::BlockingScope::~BlockingScope() {
+    if (pool_)
+        pool_->blocked_.fetch_sub(1, std::memory_order_relaxed);
+}
 
 void ThreadPool::submit(Task task, QoS qos) {
-    {
-        std::unique_lock<std::mutex> lock(mutex_);
-        tasks_.emplace(std::move(task), qos);
+    auto level = static_cast<size_t>(qos);
+    if (capacity_[level] == 0) {
+        enqueue(Item{std::move(task), enqueue_time()}, level);
+        return;
+    }
+    if (overflow_ == Overflow::DropOldest) {
+        hold(std::move(task), level, true);
+        return;
+    }
+    if (admit(level, true))
+        enqueue(Item{std::move(task), enqueue_time()}, level, true);
+}
+
+bool ThreadPool::try_submit(Task task, QoS qos) {
+    auto level = static_cast<size_t>(qos);
+    if (capacity_[level] == 0) {
+        enqueue(Item{std::move(task), enqueue_time()}, level);
+        return true;
     }
-    cv_.notify_one();
+    if (overflow_ == Overflow::DropOldest)
+        return hold(std::move(task), level, false);
+    if (!admit(level, false))
+        return false;
+    enqueue(Item{std::move(task), enqueue_time()}, level, true);
+    return true;
 }
 
-void ThreadPool::worker_loop() {
+bool ThreadPool::admit(size_t level, bool wait) {
+    if (reserve(level))
+        return true;
+
+    if (!wait || overflow_ == Overflow::DropNewest) {
+        rejected_[level].fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    BlockingScope blocking;
+    auto& space = space_[level];
     while (true) {
-        PrioritizedTask task([] {}, QoS::Background);
+        auto key = space.prepare_wait();
+        if (reserve(level)) {
+            space.cancel_wait();
+            return true;
+        }
+        if (stop_.load(std::memory_order_seq_cst)) {
+            // Shutting down: let the task through so its submitter returns.
+            space.cancel_wait();
+            pending_[level].fetch_add(1, std::memory_order_seq_cst);
+            return true;
+        }
+        space.wait(key);
+    }
+}
 
-        {
-            std::unique_lock<std::mutex> lock(mutex_);
-            cv_.wait(lock, [this] { return stop_ || !tasks_.empty(); });
+bool ThreadPool::reserve(size_t level) {
+    size_t pending = pending_[level].load(std::memory_order_seq_cst);
+    while (pending < capacity_[level]) {
+        if (pending_[level].compare_exchange_weak(pending, pending + 1, std::memory_order_seq_cst))
+            return true;
+    }
+    return false;
+}
 
-            if (stop_ && tasks_.empty())
-                return;
+bool ThreadPool::hold(Task task, size_t level, bool displace) {
+    std::unique_lock<std::mutex> lock(waiting_mutex_[level]);
+    if (reserve(level)) {
+        waiting_[level].push_back(std::move(task));
+        enqueue(Item{[this, level] { run_oldest(level); }, enqueue_time()}, level, true);
+        return true;
+    }
 
-            task = std::move(const_cast<PrioritizedTask&>(tasks_.top()));
-            tasks_.pop();
+    rejected_[level].fetch_add(1, std::memory_order_relaxed);
+    bool admitted = displace && !waiting_[level].empty();
+    if (admitted) {
+        // The new task takes the run queued for the oldest waiting one.
+        Task oldest = std::move(waiting_[level].front());
+        waiting_[level].pop_front();
+        waiting_[level].push_back(std::move(task));
+        task = std::move(oldest);
+    }
+    lock.unlock();
+
+    task = nullptr;
+    return admitted;
+}
+
+void ThreadPool::run_oldest(size_t level) {
+    std::unique_lock<std::mutex> lock(waiting_mutex_[level]);
+    Task task = std::move(waiting_[level].front());
+    waiting_[level].pop_front();
+    lock.unlock();
+    task();
+}
+
+void ThreadPool::enqueue(Item item, size_t level, bool reserved) {
+    // Count the task before it becomes visible, so a worker that pops it
+    // never takes the pending count below zero.
+    if (!reserved)
+        pending_[level].fetch_add(1, std::memory_order_seq_cst);
+
+    if (scheduler_ == Scheduler::WorkStealing) {
+        auto& queue = *local_queues_[local_queue_index()];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.tasks[level].push_back(std::move(item));
+    } else {
+        auto& shared = level_at(submit_node(), level);
+        // Keep using the overflow deque until it drains, or newer tasks would
+        // overtake the ones queued there.
+        if (shared.overflow_size.load(std::memory_order_acquire) > 0 ||
+            !shared.ring.try_push(std::move(item))) {
+            std::lock_guard<std::mutex> lock(shared.overflow_mutex);
+            shared.overflow.push_back(std::move(item));
+            shared.overflow_size.fetch_add(1, std::memory_order_release);
+        }
+    }
+
+    publish(level, 1);
+}
+
+size_t ThreadPool::local_queue_index() {
+    if (current_worker.pool == this)
+        return current_worker.index;
+    size_t next = next_queue_.fetch_add(1, std::memory_order_relaxed);
+    if (nodes_ > 1) {
+        auto& workers = node_workers_[submit_node()];
+        if (!workers.empty())
+            return workers[next % workers.size()];
+    }
+    return reserved_ + next % (min_threads_ - reserved_);
+}
+
+size_t ThreadPool::submit_node() {
+    if (nodes_ == 1)
+        return 0;
+    if (current_worker.pool == this)
+        return worker_node_[current_worker.index];
+
+    int cpu = detail::current_cpu();
+    if (cpu >= 0 && static_cast<size_t>(cpu) < cpu_node_.size() && cpu_node_[cpu] >= 0)
+        return static_cast<size_t>(cpu_node_[cpu]);
+    return next_queue_.fetch_add(1, std::memory_order_relaxed) % nodes_;
+}
+
+void ThreadPool::publish(size_t level, size_t count) {
+    if (count == 0)
+        return;
+
+    // Polling workers will find the tasks on their own; only wake parked ones
+    // for the rest. Nothing is locked while no worker is parked.
+    size_t spinners = spinning_.load(std::memory_order_seq_cst);
+    if (spinners < count) {
+        parking_.notify(count - spinners);
+    }
+    if (level == kInteractive && reserved_ > 0) {
+        reserved_parking_.notify(count);
+    }
+    if (elastic()) {
+        supervisor_idle_.notify(1);
+    }
+}
+
+void ThreadPool::worker_loop(size_t index) {
+    current_worker.pool = this;
+    current_worker.index = index;
+
+    const bool reserved = index < reserved_;
+    auto& parking = reserved ? reserved_parking_ : parking_;
+    const size_t polls = spin_count_ + yield_count_;
+    size_t idle_polls = 0;
+    bool spinning = false;
+
+    while (true) {
+        Item item;
+        size_t level;
+        if (try_pop(index, item, level)) {
+            if (spinning) {
+                spinning = false;
+                // The last polling worker is taking a task: wake a parked one
+                // if more are queued, so a burst does not stay on one thread.
+                if (spinning_.fetch_sub(1, std::memory_order_seq_cst) == 1 && has_pending())
+                    parking_.notify(1);
+            }
+            idle_polls = 0;
+            if (capacity_[level] > 0)
+                space_[level].notify(1);
+            execute(index, level, item);
+            continue;
+        }
+
+        if (stop_.load(std::memory_order_acquire) && !has_work(index))
+            break;
+
+        if (idle_polls < polls) {
+            if (!spinning && !reserved) {
+                spinning = true;
+                spinning_.fetch_add(1, std::memory_order_seq_cst);
+            }
+            if (idle_polls < spin_count_) {
+                detail::cpu_relax();
+            } else {
+                std::this_thread::yield();
+            }
+            idle_polls++;
+            continue;
+        }
+
+        if (spinning) {
+            spinning = false;
+            spinning_.fetch_sub(1, std::memory_order_seq_cst);
+        }
+
+        // Register before the final check, so a submit in between either is
+        // seen here or sees this worker as parked.
+        auto key = parking.prepare_wait();
+        if (stop_.load(std::memory_order_seq_cst) || has_work(index)) {
+            parking.cancel_wait();
+            idle_polls = 0;
+            continue;
+        }
+        idle_polls = 0;
+        if (index < min_threads_) {
+            parking.wait(key);
+            continue;
+        }
+
+        // Extra workers of an elastic pool exit after idling for idle_timeout_.
+        if (!parking_.wait_until(key, std::chrono::steady_clock::now() + idle_timeout_) &&
+            !has_pending() && retire_worker(index))
+            break;
+    }
+
+    if (spinning)
+        spinning_.fetch_sub(1, std::memory_order_seq_cst);
+}
+
+size_t ThreadPool::level_order(size_t index, size_t (&order)[kQoSLevels]) const {
+    if (index < reserved_) {
+        order[0] = kInteractive;
+        return 1;
+    }
+
+    for (size_t i = 0; i < kQoSLevels; i++) {
+        order[i] = kQoSLevels - 1 - i;
+    }
+    if (policy_ == Policy::Fair) {
+        // Start-time fair queuing: the level whose next task would start first
+        // in the worker's virtual time goes first, ties keep the higher level.
+        const auto& context = current_worker;
+        auto start = [&](size_t level) { return std::max(context.pass[level], context.vtime); };
+        std::stable_sort(order, order + kQoSLevels, [&](size_t a, size_t b) { return start(a) < start(b); });
+    }
+    return kQoSLevels;
+}
+
+void ThreadPool::charge(size_t level) {
+    if (policy_ != Policy::Fair)
+        return;
+    // A level that was idle restarts at the current virtual time rather than
+    // spending credit it built up while empty.
+    auto& context = current_worker;
+    uint64_t start = std::max(context.pass[level], context.vtime);
+    context.vtime = start;
+    context.pass[level] = start + strides_[level];
+}
+
+bool ThreadPool::try_pop(size_t index, Item& item, size_t& level) {
+    bool popped = scheduler_ == Scheduler::WorkStealing ? try_pop_local(index, item, level)
+                                                        : try_pop_global(index, item, level);
+    if (popped)
+        charge(level);
+    return popped;
+}
+
+bool ThreadPool::try_pop_global(size_t index, Item& item, size_t& level) {
+    const size_t node = worker_node_[index];
+    size_t order[kQoSLevels];
+    const size_t levels = level_order(index, order);
+
+    for (size_t k = 0; k < levels; k++) {
+        level = order[k];
+        if (pending_[level].load(std::memory_order_acquire) == 0)
+            continue;
+        if (try_pop_level(node, level, item))
+            return true;
+    }
+
+    // Own node is idle: help the others.
+    for (size_t i = 1; i < nodes_; i++) {
+        for (size_t k = 0; k < levels; k++) {
+            level = order[k];
+            if (pending_[level].load(std::memory_order_acquire) == 0)
+                continue;
+            if (try_pop_level((node + i) % nodes_, level, item))
+                return true;
         }
+    }
+    return false;
+}
 
-        try {
-            task.task();
-        } catch (const std::exception& e) {
-            std::cerr << "Task exception: " << e.what() << "\n";
-        } catch (...) {
-            std::cerr << "Task exception: unknown\n";
+bool ThreadPool::try_pop_level(size_t node, size_t level, Item& item) {
+    auto& shared = level_at(node, level);
+    bool popped = shared.ring.try_pop(item);
+
+    if (!popped && shared.overflow_size.load(std::memory_order_acquire) > 0) {
+        std::lock_guard<std::mutex> lock(shared.overflow_mutex);
+        if (!shared.overflow.empty()) {
+            item = std::move(shared.overflow.front());
+            shared.overflow.pop_front();
+            shared.overflow_size.fetch_sub(1, std::memory_order_relaxed);
+            popped = true;
         }
     }
+
+    if (popped)
+        pending_[level].fetch_sub(1, std::memory_order_relaxed);
+    return popped;
+}
+
+bool ThreadPool::try_pop_local(size_t index, Item& item, size_t& level) {
+    const auto& order = steal_order_[index];
+    if (try_steal(index, 0, steal_local_[index], item, level))
+        return true;
+    // Own node is idle: steal across nodes.
+    return try_steal(index, steal_local_[index], order.size(), item, level);
+}
+
+bool ThreadPool::try_steal(size_t index, size_t first, size_t last, Item& item, size_t& level) {
+    const auto& order = steal_order_[index];
+    size_t levels[kQoSLevels];
+    const size_t count = level_order(index, levels);
+
+    // Scan QoS levels in policy order so that priorities hold across workers: with
+    // Policy::Strict a worker never runs lower QoS work while higher QoS work is
+    // pending on its node.
+    for (size_t k = 0; k < count; k++) {
+        level = levels[k];
+        if (pending_[level].load(std::memory_order_acquire) == 0)
+            continue;
+
+        for (size_t i = first; i < last; i++) {
+            size_t victim = order[i];
+            auto& queue = *local_queues_[victim];
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            auto& tasks = queue.tasks[level];
+            if (tasks.empty())
+                continue;
+
+            if (victim == index && policy_ == Policy::Strict) {
+                item = std::move(tasks.back());
+                tasks.pop_back();
+            } else {
+                item = std::move(tasks.front());
+                tasks.pop_front();
+            }
+            pending_[level].fetch_sub(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+    return false;
+}
+
+bool ThreadPool::has_pending() const {
+    for (const auto& pending : pending_) {
+        if (pending.load(std::memory_order_seq_cst) > 0)
+            return true;
+    }
+    return false;
+}
+
+bool ThreadPool::has_work(size_t index) const {
+    if (index < reserved_)
+        return pending_[kInteractive].load(std::memory_order_seq_cst) > 0;
+    return has_pending();
+}
+
+void ThreadPool::execute(size_t index, size_t level, Item& item) {
+    auto& stats = worker_stats_[index]->levels[level];
+    detail::bump(stats.executed);
+
+    if (!metrics_enabled()) {
+        run(item.task);
+        return;
+    }
+
+    if (item.enqueued == 0) {
+        detail::task_start_ns = detail::kUntimed;
+        run(item.task);
+        detail::task_start_ns = 0;
+        return;
+    }
+
+    uint64_t start = detail::now_ns();
+    detail::task_start_ns = start;
+    run(item.task);
+    detail::task_start_ns = 0;
+    uint64_t end = detail::now_ns();
+
+    uint64_t waited = start > item.enqueued ? start - item.enqueued : 0;
+    detail::bump(stats.wait[detail::histogram_bucket(waited)]);
+    detail::bump(stats.run[detail::histogram_bucket(end - start)]);
+}
+
+void ThreadPool::run(Task& task) {
+    try {
+        task();
+    } catch (const std::exception& e) {
+        std::cerr << "Task exception: " << e.what() << "\n";
+    } catch (...) {
+        std::cerr << "Task exception: unknown\n";
+    }
+}
+
+ThreadPool::Stats ThreadPool::stats() const {
+    Stats stats;
+    for (size_t level = 0; level < kQoSLevels; level++) {
+        auto& snapshot = stats.levels[level];
+        snapshot.depth = pending_[level].load(std::memory_order_relaxed);
+        snapshot.rejected = rejected_[level].load(std::memory_order_relaxed);
+        for (const auto& worker : worker_stats_) {
+            const auto& counters = worker->levels[level];
+            snapshot.executed += counters.executed.load(std::memory_order_relaxed);
+            for (size_t b = 0; b < detail::kHistogramBuckets; b++) {
+                snapshot.wait.buckets[b] += counters.wait[b].load(std::memory_order_relaxed);
+                snapshot.run.buckets[b] += counters.run[b].load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    if (metrics_enabled()) {
+        auto& registry = detail::queue_registry();
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        for (auto* queue = registry.head; queue; queue = queue->next) {
+            stats.queues.push_back(QueueStats{
+                queue->name,
+                queue->tasks(),
+                std::chrono::nanoseconds(queue->busy_ns())});
+        }
+    }
+    return stats;
+}
+
+uint64_t ThreadPool::Histogram::count() const {
+    uint64_t total = 0;
+    for (auto bucket : buckets) {
+        total += bucket;
+    }
+    return total;
+}
+
+std::chrono::nanoseconds ThreadPool::Histogram::percentile(double q) const {
+    uint64_t total = count();
+    if (total == 0)
+        return std::chrono::nanoseconds(0);
+
+    uint64_t rank = static_cast<uint64_t>(q * static_cast<double>(total));
+    if (rank >= total)
+        rank = total - 1;
+
+    uint64_t seen = 0;
+    for (size_t b = 0; b < buckets.size(); b++) {
+        seen += buckets[b];
+        if (seen > rank)
+            return std::chrono::nanoseconds(uint64_t(1) << b);
+    }
+    return std::chrono::nanoseconds(uint64_t(1) << (buckets.size() - 1));
 }
 
 }
@@ -17,28 +17,166 @@
 #include <TurboQ/timer.hpp>
 #include <TurboQ/queue.hpp>
 
+#include <algorithm>
+#include <assert.h>
+
 namespace turboq {
 
-Timer& Timer::instance() {
-    static Timer tq;
+Timer& Timer::instance(Backend backend) {
+    static Timer tq(backend);
     return tq;
 }
 
-void Timer::schedule(Task task,
-                          std::chrono::steady_clock::time_point when,
-                          turboq::Queue& queue) {
+Timer::Handle Timer::schedule(Task task,
+                              std::chrono::steady_clock::time_point when,
+                              turboq::Queue& queue,
+                              std::chrono::milliseconds leeway) {
+    auto entry = std::make_shared<Entry>(std::move(task), &queue, leeway);
+    insert(ScheduledTask{when, coalesce(when, leeway), 0, entry});
+    return Handle(link_, std::move(entry));
+}
+
+Timer::Handle Timer::schedule_every(Task task,
+                                    std::chrono::steady_clock::time_point first,
+                                    std::chrono::milliseconds period,
+                                    turboq::Queue& queue,
+                                    Missed missed,
+                                    std::chrono::milliseconds leeway) {
+    assert(period.count() > 0 && "Timer::schedule_every needs a positive period");
+    auto entry = std::make_shared<Entry>(std::move(task), &queue, leeway);
+    entry->period = period;
+    entry->missed = missed;
+    insert(ScheduledTask{first, coalesce(first, leeway), 0, entry});
+    return Handle(link_, std::move(entry));
+}
+
+void Timer::insert(ScheduledTask task) {
+    bool wake;
     {
         std::unique_lock<std::mutex> lock(mutex_);
-        tasks_.emplace(ScheduledTask{when, std::move(task), &queue});
+        // The dispatch thread only needs a wakeup if it sleeps past the new deadline.
+        wake = task.deadline < wake_at_;
+        store(std::move(task));
+        purge_stale();
     }
-    cv_.notify_one();
+    if (wake) cv_.notify_one();
 }
 
-Timer::Timer() : stop_(false) {
+bool Timer::is_stale(const ScheduledTask& task) {
+    return task.entry->state.load(std::memory_order_acquire) !=
+           make_state(task.generation, Status::Pending);
+}
+
+void Timer::purge_stale() {
+    // Stale records are normally dropped when they come due; purge them once
+    // they make up half of what is stored, so that cancel and reschedule
+    // churn cannot grow the timer.
+    constexpr size_t kMinStale = 64;
+    size_t stale = link_->stale.load(std::memory_order_relaxed);
+    if (stale < kMinStale || stale * 2 < size())
+        return;
+
+    size_t removed = 0;
+    if (backend_ == Backend::Wheel) {
+        removed = wheel_.remove_if(is_stale);
+    } else {
+        std::vector<ScheduledTask> live;
+        live.reserve(tasks_.size());
+        for (; !tasks_.empty(); tasks_.pop()) {
+            auto& task = const_cast<ScheduledTask&>(tasks_.top());
+            if (is_stale(task)) {
+                removed++;
+            } else {
+                live.push_back(std::move(task));
+            }
+        }
+        tasks_ = decltype(tasks_)(std::greater<>(), std::move(live));
+    }
+    forget_stale(removed);
+}
+
+void Timer::forget_stale(size_t count) {
+    // A record can be dropped before its cancel() has counted it; never go below zero.
+    size_t stale = link_->stale.load(std::memory_order_relaxed);
+    while (!link_->stale.compare_exchange_weak(stale, stale - std::min(stale, count),
+                                               std::memory_order_relaxed)) {
+    }
+}
+
+void Timer::store(ScheduledTask task) {
+    if (backend_ == Backend::Wheel) {
+        auto tick = to_tick(task.deadline);
+        wheel_.insert(tick, std::move(task));
+    } else {
+        tasks_.push(std::move(task));
+    }
+}
+
+bool Timer::Handle::cancel() {
+    if (!entry_)
+        return false;
+
+    uint64_t state = entry_->state.load(std::memory_order_acquire);
+    while (static_cast<Status>(state & 3) == Status::Pending) {
+        uint64_t cancelled = make_state(state >> 2, Status::Cancelled);
+        if (entry_->state.compare_exchange_weak(state, cancelled, std::memory_order_acq_rel)) {
+            // Nobody touches a one-shot task after a successful cancel; release its
+            // captures now. A periodic run may still be in flight and keeps them.
+            if (entry_->period.count() == 0)
+                entry_->task = nullptr;
+            if (auto link = timer_.lock())
+                link->stale.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+    return false;
+}
+
+bool Timer::Handle::reschedule(std::chrono::steady_clock::time_point when) {
+    auto link = timer_.lock();
+    if (!entry_ || !link)
+        return false;
+
+    // Holding the link keeps the timer alive until the new record is stored.
+    std::lock_guard<std::mutex> guard(link->mutex);
+    Timer* timer = link->timer;
+    if (!timer)
+        return false;
+
+    uint64_t state = entry_->state.load(std::memory_order_acquire);
+    while (static_cast<Status>(state & 3) == Status::Pending) {
+        uint64_t generation = (state >> 2) + 1;
+        if (entry_->state.compare_exchange_weak(state, make_state(generation, Status::Pending),
+                                                std::memory_order_acq_rel)) {
+            link->stale.fetch_add(1, std::memory_order_relaxed);
+            timer->insert(ScheduledTask{when, timer->coalesce(when, entry_->leeway), generation, entry_});
+            return true;
+        }
+    }
+    return false;
+}
+
+bool Timer::Handle::pending() const {
+    return entry_ && !timer_.expired() &&
+           static_cast<Status>(entry_->state.load(std::memory_order_acquire) & 3) == Status::Pending;
+}
+
+Timer::Timer(Backend backend)
+    : backend_(backend),
+      epoch_(std::chrono::steady_clock::now()),
+      wakeups_(0),
+      link_(std::make_shared<Link>(this)),
+      wake_at_(std::chrono::steady_clock::time_point::max()),
+      stop_(false) {
     worker_ = std::thread([this] { run(); });
 }
 
 Timer::~Timer() {
+    {
+        // Wait for handles in reschedule() and keep later ones out.
+        std::lock_guard<std::mutex> guard(link_->mutex);
+        link_->timer = nullptr;
+    }
     {
         std::unique_lock<std::mutex> lock(mutex_);
         stop_ = true;
@@ -48,24 +186,185 @@ Timer::~Timer() {
 }
 
 void Timer::run() {
+    std::vector<ScheduledTask> batch;
+    std::vector<Task> tasks;
+
     std::unique_lock<std::mutex> lock(mutex_);
     while (!stop_) {
-        if (tasks_.empty()) {
-            cv_.wait(lock, [this] { return stop_ || !tasks_.empty(); });
+        purge_stale();
+        if (empty()) {
+            wake_at_ = std::chrono::steady_clock::time_point::max();
+            cv_.wait(lock, [this] { return stop_ || !empty(); });
         } else {
-            auto next = tasks_.top();
-            if (cv_.wait_until(lock, next.when, [this, &next] {
-                    return stop_ || tasks_.top().when < next.when;
+            wake_at_ = next_deadline();
+            if (cv_.wait_until(lock, wake_at_, [this] {
+                    return stop_ || next_deadline() < wake_at_;
                 })) {
                 continue;
             }
 
-            tasks_.pop();
+            collect_expired(std::chrono::steady_clock::now());
+            if (expired_.empty())
+                continue;
+
+            // Swap buffers so that both keep their capacity across wakeups.
+            batch.swap(expired_);
             lock.unlock();
-            next.queue->async(std::move(next.task));
+            wakeups_.fetch_add(1, std::memory_order_relaxed);
+            submit(batch, tasks);
+            batch.clear();
             lock.lock();
         }
     }
 }
 
+void Timer::submit(std::vector<ScheduledTask>& batch, std::vector<Task>& tasks) {
+    if (batch.size() == 1) {
+        batch.front().entry->queue->enqueue(take_task(batch.front().entry));
+        return;
+    }
+
+    // One enqueue_batch() per queue, keeping the batch's order within a queue.
+    // Each pass takes every entry of one queue and resets it, so this costs
+    // one scan per distinct queue and, unlike sorting, allocates nothing.
+    for (size_t first = 0; first < batch.size(); first++) {
+        if (!batch[first].entry)
+            continue;
+        Queue* queue = batch[first].entry->queue;
+        for (size_t i = first; i < batch.size(); i++) {
+            if (batch[i].entry && batch[i].entry->queue == queue) {
+                tasks.push_back(take_task(batch[i].entry));
+                batch[i].entry.reset();
+            }
+        }
+        queue->enqueue_batch(tasks);
+        tasks.clear();
+    }
+}
+
+Timer::Task Timer::take_task(const std::shared_ptr<Entry>& entry) {
+    if (entry->period.count() == 0)
+        return std::move(entry->task);
+    return [entry] { run_periodic(entry); };
+}
+
+void Timer::run_periodic(const std::shared_ptr<Entry>& entry) {
+    struct Finish {
+        const std::shared_ptr<Entry>& entry;
+        ~Finish() {
+            // Owed runs follow on the queue without going back through the timer.
+            if (entry->runs.fetch_sub(1, std::memory_order_acq_rel) != 1)
+                entry->queue->enqueue([entry = entry] { run_periodic(entry); });
+        }
+    } finish{entry};
+
+    auto status = static_cast<Status>(entry->state.load(std::memory_order_acquire) & 3);
+    if (status != Status::Cancelled)
+        entry->task();
+}
+
+bool Timer::empty() const {
+    return backend_ == Backend::Wheel ? wheel_.empty() : tasks_.empty();
+}
+
+size_t Timer::size() const {
+    return backend_ == Backend::Wheel ? wheel_.size() : tasks_.size();
+}
+
+std::chrono::steady_clock::time_point Timer::next_deadline() const {
+    if (backend_ == Backend::Wheel) {
+        auto tick = wheel_.next_expiration();
+        return tick ? epoch_ + std::chrono::milliseconds(*tick)
+                    : std::chrono::steady_clock::time_point::max();
+    }
+    return tasks_.empty() ? std::chrono::steady_clock::time_point::max() : tasks_.top().deadline;
+}
+
+void Timer::collect_expired(std::chrono::steady_clock::time_point now) {
+    // Claim the entry before dispatch; cancelled or rescheduled records are dropped here.
+    auto claim = [this, now](ScheduledTask&& task) {
+        Entry& entry = *task.entry;
+        uint64_t expected = make_state(task.generation, Status::Pending);
+        if (entry.period.count() == 0) {
+            if (entry.state.compare_exchange_strong(expected,
+                                                    make_state(task.generation, Status::Fired),
+                                                    std::memory_order_acq_rel)) {
+                expired_.push_back(std::move(task));
+            } else {
+                forget_stale(1);
+            }
+            return;
+        }
+
+        if (entry.state.load(std::memory_order_acquire) != expected) {
+            forget_stale(1);
+            return;
+        }
+
+        // Count every tick that has come due and stay on the original grid.
+        uint32_t ticks = 1;
+        if (now > task.when)
+            ticks += static_cast<uint32_t>((now - task.when) / entry.period);
+
+        bool idle;
+        if (entry.missed == Missed::CatchUp) {
+            idle = entry.runs.fetch_add(ticks, std::memory_order_acq_rel) == 0;
+        } else {
+            uint32_t none = 0;
+            idle = entry.runs.compare_exchange_strong(none, 1, std::memory_order_acq_rel);
+        }
+        if (idle)
+            expired_.push_back(task);
+
+        task.when += entry.period * ticks;
+        task.deadline = coalesce(task.when, entry.leeway);
+        rearm_.push_back(std::move(task));
+    };
+
+    if (backend_ == Backend::Wheel) {
+        // Round down so that a tick is only processed once it has fully elapsed.
+        auto tick = static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::milliseconds>(now - epoch_).count());
+        wheel_.advance(tick, claim);
+    } else {
+        // The heap is ordered by deadline; also take the following tasks whose
+        // window has opened, so that they share this wakeup.
+        while (!tasks_.empty() && tasks_.top().when <= now) {
+            claim(std::move(const_cast<ScheduledTask&>(tasks_.top())));
+            tasks_.pop();
+        }
+    }
+
+    // Periodic records go back only now, so none fires twice in one pass.
+    for (auto& task : rearm_) {
+        store(std::move(task));
+    }
+    rearm_.clear();
+}
+
+std::chrono::steady_clock::time_point Timer::coalesce(std::chrono::steady_clock::time_point when,
+                                                      std::chrono::milliseconds leeway) const {
+    if (leeway.count() <= 0 || when <= epoch_)
+        return when;
+
+    // Fire at the last multiple of the largest power-of-two number of
+    // milliseconds that fits in the leeway; timers whose windows overlap
+    // mostly land on the same point.
+    auto grid = std::chrono::milliseconds::rep(1);
+    while (grid * 2 <= leeway.count()) {
+        grid *= 2;
+    }
+    auto latest = std::chrono::duration_cast<std::chrono::milliseconds>(when + leeway - epoch_).count();
+    auto deadline = epoch_ + std::chrono::milliseconds(latest / grid * grid);
+    return std::max(deadline, when);
+}
+
+uint64_t Timer::to_tick(std::chrono::steady_clock::time_point when) const {
+    if (when <= epoch_)
+        return 0;
+    // Round up so that a task never fires before its deadline.
+    auto elapsed = std::chrono::ceil<std::chrono::milliseconds>(when - epoch_);
+    return static_cast<uint64_t>(elapsed.count());
+}
+
 } 
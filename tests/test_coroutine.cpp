@@ -0,0 +1,86 @@
+#if defined(__cpp_impl_coroutine)
+
+#include <catch2/catch_test_macros.hpp>
+#include <TurboQ/coroutine.hpp>
+#include "test_helpers.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+
+using namespace turboq;
+using namespace std::chrono_literals;
+
+namespace {
+
+task<int> answer(Queue& queue) {
+    co_await queue.schedule();
+    co_return 42;
+}
+
+task<int> add_after(Queue& queue, int value, std::chrono::milliseconds delay) {
+    co_await queue.after(delay);
+    co_return value + co_await answer(queue);
+}
+
+task<> fail(Queue& queue) {
+    co_await queue.schedule();
+    throw std::runtime_error("failure");
+}
+
+}
+
+TEST_CASE("Coroutine resumes on the queue after schedule", "[Coroutine]") {
+    Queue sut("coroutine_schedule_test", Queue::Type::Serial, ThreadPool::QoS::Utility);
+    auto caller = std::this_thread::get_id();
+
+    auto thread = sync_wait([](Queue& queue) -> task<std::thread::id> {
+        co_await queue.schedule();
+        co_return std::this_thread::get_id();
+    }(sut));
+
+    REQUIRE(thread != caller);
+}
+
+TEST_CASE("Coroutine after waits for the delay", "[Coroutine]") {
+    Queue sut("coroutine_after_test", Queue::Type::Concurrent, ThreadPool::QoS::Utility);
+
+    auto start = std::chrono::steady_clock::now();
+    int result = sync_wait(add_after(sut, 1, 50ms));
+
+    REQUIRE(result == 43);
+    REQUIRE(std::chrono::steady_clock::now() - start >= 50ms);
+}
+
+TEST_CASE("Coroutine spawn returns a Future", "[Coroutine]") {
+    Queue sut("coroutine_spawn_test", Queue::Type::Serial, ThreadPool::QoS::Utility);
+
+    auto future = spawn(sut, answer(sut));
+
+    REQUIRE(future.get() == 42);
+}
+
+TEST_CASE("Coroutine propagates exceptions to the awaiter", "[Coroutine]") {
+    Queue sut("coroutine_exception_test", Queue::Type::Serial, ThreadPool::QoS::Utility);
+
+    REQUIRE_THROWS_AS(sync_wait(fail(sut)), std::runtime_error);
+}
+
+TEST_CASE("Coroutine chains many hops between queues", "[Coroutine]") {
+    Queue first("coroutine_first", Queue::Type::Serial, ThreadPool::QoS::Utility);
+    Queue second("coroutine_second", Queue::Type::Serial, ThreadPool::QoS::Utility);
+
+    int hops = sync_wait([](Queue& a, Queue& b) -> task<int> {
+        int count = 0;
+        for (int i = 0; i < 1000; i++) {
+            co_await (i % 2 ? a : b).schedule();
+            count++;
+        }
+        co_return count;
+    }(first, second));
+
+    REQUIRE(hops == 1000);
+}
+
+#endif
@@ -0,0 +1,96 @@
+#include <catch2/catch_test_macros.hpp>
+#include <TurboQ/future.hpp>
+#include <TurboQ/queue.hpp>
+#include "test_helpers.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+using namespace turboq;
+using namespace std::chrono_literals;
+
+TEST_CASE("Future returns the result of Queue::async_result", "[Future]") {
+    Queue sut("future_test", Queue::Type::Serial, ThreadPool::QoS::Utility);
+
+    auto future = sut.async_result([] { return 21 * 2; });
+
+    REQUIRE(future.valid());
+    REQUIRE(future.get() == 42);
+    REQUIRE_FALSE(future.valid());
+}
+
+TEST_CASE("Future returns the result of ThreadPool::submit_result", "[Future]") {
+    ThreadPool pool(2);
+
+    auto future = pool.submit_result([] { return std::string("done"); }, ThreadPool::QoS::UserInitiated);
+
+    REQUIRE(future.get() == "done");
+}
+
+TEST_CASE("Future supports move-only results and void", "[Future]") {
+    Queue sut("future_types_test", Queue::Type::Concurrent, ThreadPool::QoS::Utility);
+    std::atomic<bool> executed{false};
+
+    auto pointer = sut.async_result([] { return std::make_unique<int>(7); });
+    auto nothing = sut.async_result([&] { executed = true; });
+
+    REQUIRE(*pointer.get() == 7);
+    nothing.get();
+    REQUIRE(executed.load());
+}
+
+TEST_CASE("Future rethrows exceptions from the task", "[Future]") {
+    Queue sut("future_exception_test", Queue::Type::Serial, ThreadPool::QoS::Utility);
+
+    auto future = sut.async_result([]() -> int { throw std::runtime_error("failure"); });
+
+    REQUIRE_THROWS_AS(future.get(), std::runtime_error);
+}
+
+TEST_CASE("Future then continues on the target queue", "[Future]") {
+    Queue source("future_source", Queue::Type::Concurrent, ThreadPool::QoS::Utility);
+    Queue target("future_target", Queue::Type::Serial, ThreadPool::QoS::Utility);
+
+    std::atomic<bool> release{false};
+    auto future = source.async_result([&] {
+        while (!release) std::this_thread::yield();
+        return 20;
+    });
+
+    auto chained = future
+        .then(target, [](int value) { return value + 1; })
+        .then(target, [](int value) { return std::to_string(value * 2); });
+
+    REQUIRE_FALSE(chained.ready());
+    release = true;
+
+    REQUIRE(chained.get() == "42");
+}
+
+TEST_CASE("Future then runs when the result is already available", "[Future]") {
+    Queue sut("future_ready_test", Queue::Type::Serial, ThreadPool::QoS::Utility);
+
+    auto future = sut.async_result([] { return 1; });
+    REQUIRE(test_helpers::wait_until([&]{ return future.ready(); }));
+
+    std::atomic<int> seen{0};
+    auto done = future.then(sut, [&](int value) { seen = value; });
+    done.get();
+
+    REQUIRE(seen.load() == 1);
+}
+
+TEST_CASE("Future then forwards exceptions without running the continuation", "[Future]") {
+    Queue sut("future_then_exception_test", Queue::Type::Serial, ThreadPool::QoS::Utility);
+    std::atomic<bool> called{false};
+
+    auto chained = sut.async_result([]() -> int { throw std::logic_error("failure"); })
+        .then(sut, [&](int) { called = true; return 0; });
+
+    REQUIRE_THROWS_AS(chained.get(), std::logic_error);
+    REQUIRE_FALSE(called.load());
+}
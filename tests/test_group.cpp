@@ -0,0 +1,84 @@
+#include <catch2/catch_test_macros.hpp>
+#include <TurboQ/group.hpp>
+#include <TurboQ/queue.hpp>
+#include "test_helpers.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+
+using namespace turboq;
+using namespace std::chrono_literals;
+
+TEST_CASE("Group waits for a fan-out across queues", "[Group]") {
+    Queue concurrent("group_concurrent", Queue::Type::Concurrent, ThreadPool::QoS::Utility);
+    Queue serial("group_serial", Queue::Type::Serial, ThreadPool::QoS::Utility);
+    Group group;
+    std::atomic<int> counter{0};
+
+    for (int i = 0; i < 1000; i++) {
+        Queue& queue = (i % 2 == 0) ? concurrent : serial;
+        queue.async(group, [&] { counter++; });
+    }
+
+    REQUIRE(group.wait(5s));
+    REQUIRE(counter == 1000);
+}
+
+TEST_CASE("Group wait times out while tasks are outstanding", "[Group]") {
+    Queue sut("group_timeout", Queue::Type::Serial, ThreadPool::QoS::Utility);
+    Group group;
+    std::atomic<bool> release{false};
+
+    sut.async(group, [&] {
+        while (!release) {
+            std::this_thread::sleep_for(1ms);
+        }
+    });
+
+    REQUIRE_FALSE(group.wait(20ms));
+    release = true;
+    REQUIRE(group.wait(5s));
+}
+
+TEST_CASE("Group leaves when a task throws", "[Group]") {
+    Queue sut("group_throw", Queue::Type::Concurrent, ThreadPool::QoS::Utility);
+    Group group;
+
+    sut.async(group, [] { throw std::runtime_error("fail"); });
+
+    REQUIRE(group.wait(5s));
+}
+
+TEST_CASE("Group notify runs once the group is empty", "[Group]") {
+    Queue worker("group_worker", Queue::Type::Concurrent, ThreadPool::QoS::Utility);
+    Queue target("group_target", Queue::Type::Serial, ThreadPool::QoS::Utility);
+    Group group;
+    std::atomic<int> counter{0};
+    std::atomic<int> observed{-1};
+
+    group.enter();
+    for (int i = 0; i < 100; i++) {
+        worker.async(group, [&] { counter++; });
+    }
+    group.notify(target, [&] { observed = counter.load(); });
+
+    std::this_thread::sleep_for(10ms);
+    REQUIRE(observed == -1);
+
+    group.leave();
+    REQUIRE(test_helpers::wait_until([&] { return observed != -1; }));
+    REQUIRE(observed == 100);
+}
+
+TEST_CASE("Group notify on an empty group submits immediately", "[Group]") {
+    Queue target("group_empty", Queue::Type::Serial, ThreadPool::QoS::Utility);
+    Group group;
+    std::atomic<bool> notified{false};
+
+    REQUIRE(group.wait(0ms));
+    group.notify(target, [&] { notified = true; });
+
+    REQUIRE(test_helpers::wait_until([&] { return notified.load(); }));
+}
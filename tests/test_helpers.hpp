@@ -1,10 +1,14 @@
 #pragma once
+#include <atomic>
 #include <chrono>
 #include <thread>
 #include <functional>
 
 namespace test_helpers {
 
+// Heap allocations on the calling thread, counted by the operator new in test_task.cpp.
+inline thread_local size_t allocations = 0;
+
 inline bool wait_until(std::function<bool()> condition,
                        std::chrono::milliseconds timeout = std::chrono::milliseconds(1000),
                        std::chrono::milliseconds interval = std::chrono::milliseconds(1))
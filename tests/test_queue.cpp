@@ -1,10 +1,21 @@
 #include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
 #include <TurboQ/queue.hpp>
+#include <TurboQ/group.hpp>
+#include <TurboQ/source.hpp>
+#if defined(__cpp_impl_coroutine)
+#include <TurboQ/coroutine.hpp>
+#endif
 #include "test_helpers.hpp"
 
+#include <algorithm>
 #include <atomic>
+#include <memory>
+#include <string>
 #include <vector>
 #include <chrono>
+#include <future>
+#include <stdexcept>
 #include <thread>
 
 using namespace turboq;
@@ -82,3 +93,624 @@ TEST_CASE("Queue global concurrent queues work", "[Queue]") {
 
     REQUIRE(wait_until([&]{ return counter.load() == 2; }));
 }
+
+TEST_CASE("Queue async_after returns a cancellable handle", "[Queue]") {
+    Queue sut("timer_cancel_test", Queue::Type::Concurrent, ThreadPool::QoS::Utility);
+    std::atomic<bool> cancelled_executed{false};
+    std::atomic<bool> executed{false};
+
+    auto cancelled = sut.async_after(50ms, [&] { cancelled_executed = true; });
+    sut.async_after(60ms, [&] { executed = true; });
+
+    REQUIRE(cancelled.cancel());
+    REQUIRE(wait_until([&]{ return executed.load(); }));
+    REQUIRE_FALSE(cancelled_executed.load());
+}
+
+TEST_CASE("Queue async_at handle moves a task earlier", "[Queue]") {
+    Queue sut("timer_reschedule_test", Queue::Type::Serial, ThreadPool::QoS::Utility);
+    std::atomic<bool> executed{false};
+
+    auto start = std::chrono::steady_clock::now();
+    auto handle = sut.async_at(start + 10s, [&] { executed = true; });
+    REQUIRE(handle.reschedule(start + 20ms));
+
+    REQUIRE(wait_until([&]{ return executed.load(); }));
+}
+
+TEST_CASE("Queue async_batch keeps serial order", "[Queue]") {
+    Queue sut("serial_batch_test", Queue::Type::Serial, ThreadPool::QoS::Utility);
+    std::vector<int> order;
+    std::mutex m;
+
+    std::vector<Queue::Task> tasks;
+    for (int i = 0; i < 100; i++) {
+        tasks.emplace_back([&, i] {
+            std::lock_guard<std::mutex> lock(m);
+            order.push_back(i);
+        });
+    }
+    sut.async_batch(tasks);
+
+    REQUIRE(wait_until([&]{ std::lock_guard<std::mutex> lock(m); return order.size() == 100; }));
+    for (int i = 0; i < 100; i++) {
+        REQUIRE(order[i] == i);
+    }
+}
+
+TEST_CASE("Queue async_batch runs concurrent tasks", "[Queue]") {
+    Queue sut("concurrent_batch_test", Queue::Type::Concurrent, ThreadPool::QoS::Utility);
+    std::atomic<int> counter{0};
+
+    std::vector<Queue::Task> tasks;
+    for (int i = 0; i < 100; i++) {
+        tasks.emplace_back([&] { counter++; });
+    }
+    sut.async_batch(tasks);
+
+    REQUIRE(wait_until([&]{ return counter.load() == 100; }));
+}
+
+TEST_CASE("Queue Serial drains backlog on one worker", "[Queue]") {
+    Queue sut("serial_drain_test", Queue::Type::Serial, ThreadPool::QoS::Utility);
+    std::atomic<bool> release{false};
+    std::vector<std::thread::id> threads;
+    std::mutex m;
+
+    sut.async([&] { while (!release) std::this_thread::yield(); });
+    for (int i = 0; i < 10; i++) {
+        sut.async([&] {
+            std::lock_guard<std::mutex> lock(m);
+            threads.push_back(std::this_thread::get_id());
+        });
+    }
+    release = true;
+
+    REQUIRE(wait_until([&]{ std::lock_guard<std::mutex> lock(m); return threads.size() == 10; }));
+    for (auto& id : threads) {
+        REQUIRE(id == threads.front());
+    }
+}
+
+TEST_CASE("Queue Serial keeps order with a small quantum", "[Queue]") {
+    Queue sut("serial_quantum_test", Queue::Type::Serial, ThreadPool::QoS::Utility);
+    sut.set_quantum(Queue::Quantum{1, std::chrono::microseconds(0)});
+
+    std::vector<int> order;
+    std::mutex m;
+
+    for (int i = 0; i < 50; i++) {
+        sut.async([&, i] {
+            std::lock_guard<std::mutex> lock(m);
+            order.push_back(i);
+        });
+    }
+
+    REQUIRE(wait_until([&]{ std::lock_guard<std::mutex> lock(m); return order.size() == 50; }));
+    for (int i = 0; i < 50; i++) {
+        REQUIRE(order[i] == i);
+    }
+}
+
+TEST_CASE("Queue Serial accepts concurrent producers", "[Queue]") {
+    Queue sut("serial_mpsc_test", Queue::Type::Serial, ThreadPool::QoS::Utility);
+    constexpr int producers = 4;
+    constexpr int per_producer = 1000;
+
+    std::atomic<int> running{0};
+    std::atomic<bool> overlapped{false};
+    std::vector<int> last(producers, -1);
+    std::atomic<bool> out_of_order{false};
+    std::atomic<int> counter{0};
+
+    std::vector<std::thread> threads;
+    for (int p = 0; p < producers; p++) {
+        threads.emplace_back([&, p] {
+            for (int i = 0; i < per_producer; i++) {
+                sut.async([&, p, i] {
+                    if (running.fetch_add(1) != 0) overlapped = true;
+                    // Only one task runs at a time, so plain access is safe here.
+                    if (last[p] + 1 != i) out_of_order = true;
+                    last[p] = i;
+                    running.fetch_sub(1);
+                    counter++;
+                });
+            }
+        });
+    }
+    for (auto& t : threads) t.join();
+
+    REQUIRE(wait_until([&]{ return counter.load() == producers * per_producer; }, 5000ms));
+    REQUIRE_FALSE(overlapped.load());
+    REQUIRE_FALSE(out_of_order.load());
+}
+
+TEST_CASE("Queue Serial recycles nodes for producers outside the pool", "[Queue]") {
+    constexpr int kTasks = 256;
+    std::atomic<int> done{0};
+
+    auto post = [&] {
+        // Destroying the queue waits for its drain, which hands the nodes back.
+        Queue sut("recycle", Queue::Type::Serial, ThreadPool::QoS::Utility);
+        size_t before = allocations;
+        for (int i = 0; i < kTasks; i++) {
+            sut.async([&] { done++; });
+        }
+        size_t allocated = allocations - before;
+        REQUIRE(wait_until([&] { return done.load() % kTasks == 0; }));
+        return allocated;
+    };
+
+    post();
+    REQUIRE(post() == 0);
+}
+
+TEST_CASE("Queue Concurrent batches from a reused buffer do not allocate", "[Queue]") {
+    constexpr int kBatch = 8;
+    Queue sut("batch_alloc", Queue::Type::Concurrent, ThreadPool::QoS::Utility);
+    std::atomic<int> done{0};
+    std::vector<Task> tasks;
+    tasks.reserve(kBatch);
+
+    // The timer hands its expired tasks over the same way, once per wakeup.
+    auto post = [&] {
+        size_t before = allocations;
+        for (int i = 0; i < kBatch; i++) {
+            tasks.emplace_back([&] { done++; });
+        }
+        sut.async_batch(tasks);
+        tasks.clear();
+        size_t allocated = allocations - before;
+        REQUIRE(wait_until([&] { return done.load() % kBatch == 0; }));
+        return allocated;
+    };
+
+    post();
+    for (int i = 0; i < 10; i++) {
+        REQUIRE(post() == 0);
+    }
+}
+
+TEST_CASE("Queue apply visits every index once", "[Queue]") {
+    Queue sut("apply_test", Queue::Type::Concurrent, ThreadPool::QoS::Utility);
+    constexpr size_t count = 100000;
+    std::vector<std::atomic<int>> visits(count);
+
+    sut.apply(count, [&](size_t i) { visits[i]++; });
+
+    for (auto& v : visits) {
+        REQUIRE(v.load() == 1);
+    }
+}
+
+TEST_CASE("Queue apply runs in order on a serial queue", "[Queue]") {
+    Queue sut("apply_serial_test", Queue::Type::Serial, ThreadPool::QoS::Utility);
+    std::vector<size_t> order;
+
+    sut.apply(100, [&](size_t i) { order.push_back(i); });
+
+    REQUIRE(order.size() == 100);
+    for (size_t i = 0; i < order.size(); i++) {
+        REQUIRE(order[i] == i);
+    }
+}
+
+TEST_CASE("Queue apply rethrows exceptions from the loop body", "[Queue]") {
+    Queue sut("apply_exception_test", Queue::Type::Concurrent, ThreadPool::QoS::Utility);
+
+    REQUIRE_THROWS_AS(sut.apply(1000, [&](size_t i) {
+        if (i == 500) throw std::runtime_error("failure");
+    }), std::runtime_error);
+}
+
+TEST_CASE("Queue parallel_for visits every element", "[Queue]") {
+    Queue sut("parallel_for_test", Queue::Type::Concurrent, ThreadPool::QoS::Utility);
+    std::vector<int> values(10000, 1);
+
+    sut.parallel_for(values, [](int& value) { value *= 3; });
+
+    for (int value : values) {
+        REQUIRE(value == 3);
+    }
+}
+
+TEST_CASE("Queue barrier runs alone between concurrent tasks", "[Queue]") {
+    Queue sut("barrier_test", Queue::Type::Concurrent, ThreadPool::QoS::Utility);
+    std::atomic<int> active{0};
+    std::atomic<int> before{0};
+    std::atomic<int> after{0};
+    std::atomic<bool> overlapped{false};
+    std::atomic<bool> barrier_done{false};
+    std::atomic<bool> reordered{false};
+
+    for (int i = 0; i < 50; i++) {
+        sut.async([&] {
+            active++;
+            std::this_thread::sleep_for(100us);
+            before++;
+            active--;
+        });
+    }
+    sut.async_barrier([&] {
+        if (active.load() != 0 || before.load() != 50)
+            overlapped = true;
+        std::this_thread::sleep_for(1ms);
+        barrier_done = true;
+    });
+    for (int i = 0; i < 50; i++) {
+        sut.async([&] {
+            if (!barrier_done.load())
+                reordered = true;
+            after++;
+        });
+    }
+
+    REQUIRE(wait_until([&] { return after.load() == 50; }));
+    REQUIRE_FALSE(overlapped);
+    REQUIRE_FALSE(reordered);
+}
+
+TEST_CASE("Queue barriers protect unsynchronized shared state", "[Queue]") {
+    Queue sut("barrier_rw_test", Queue::Type::Concurrent, ThreadPool::QoS::Utility);
+    std::vector<int> shared;
+    std::atomic<size_t> reads{0};
+
+    for (int i = 0; i < 100; i++) {
+        sut.async_barrier([&, i] { shared.push_back(i); });
+        std::vector<Queue::Task> readers;
+        for (int j = 0; j < 4; j++) {
+            readers.emplace_back([&] {
+                size_t size = shared.size();
+                if (size > 0 && shared[size - 1] == static_cast<int>(size - 1))
+                    reads++;
+            });
+        }
+        sut.async_batch(readers);
+    }
+    sut.sync_barrier([] {});
+
+    REQUIRE(shared.size() == 100);
+    REQUIRE(reads == 400);
+}
+
+TEST_CASE("Queue sync_barrier waits for earlier tasks", "[Queue]") {
+    Queue sut("sync_barrier_test", Queue::Type::Concurrent, ThreadPool::QoS::Utility);
+    std::atomic<int> counter{0};
+
+    for (int i = 0; i < 100; i++) {
+        sut.async([&] { counter++; });
+    }
+    int seen = -1;
+    sut.sync_barrier([&] { seen = counter.load(); });
+
+    REQUIRE(seen == 100);
+}
+
+TEST_CASE("Queue barrier on a serial queue keeps order", "[Queue]") {
+    Queue sut("serial_barrier_test", Queue::Type::Serial, ThreadPool::QoS::Utility);
+    std::vector<int> order;
+    std::atomic<int> done{0};
+
+    sut.async([&] { order.push_back(1); done++; });
+    sut.async_barrier([&] { order.push_back(2); done++; });
+    sut.async([&] { order.push_back(3); done++; });
+
+    REQUIRE(wait_until([&] { return done.load() == 3; }));
+    REQUIRE(order == std::vector<int>{1, 2, 3});
+}
+
+TEST_CASE("Queue barriers on global queues run like ordinary tasks", "[Queue]") {
+    auto& sut = Queue::global(ThreadPool::QoS::Utility);
+    std::atomic<int> counter{0};
+
+    for (int i = 0; i < 100; i++) {
+        sut.async([&] { counter++; });
+    }
+    sut.async_barrier([&] { counter++; });
+    sut.sync_barrier([&] { counter++; });
+
+    REQUIRE(wait_until([&] { return counter.load() == 102; }));
+}
+
+TEST_CASE("Queue apply against one async per index", "[.][benchmark][Queue]") {
+    Queue sut("apply_bench", Queue::Type::Concurrent, ThreadPool::QoS::Utility);
+    constexpr size_t count = 100000;
+    std::vector<double> values(count, 1.0);
+
+    BENCHMARK("async per index") {
+        std::atomic<size_t> done{0};
+        for (size_t i = 0; i < count; i++) {
+            sut.async([&, i] { values[i] *= 1.0001; done++; });
+        }
+        while (done.load() != count) std::this_thread::yield();
+        return values[0];
+    };
+
+    BENCHMARK("apply") {
+        sut.apply(count, [&](size_t i) { values[i] *= 1.0001; });
+        return values[0];
+    };
+}
+
+TEST_CASE("Queue throughput shows up in ThreadPool stats", "[Queue]") {
+    auto& pool = ThreadPool::instance();
+    pool.set_metrics_enabled(true);
+
+    Queue serial("stats_serial", Queue::Type::Serial, ThreadPool::QoS::Utility);
+    Queue concurrent("stats_concurrent", Queue::Type::Concurrent, ThreadPool::QoS::Utility);
+    std::atomic<int> counter{0};
+
+    for (int i = 0; i < 100; i++) {
+        serial.async([&] { counter++; });
+        concurrent.async([&] { counter++; });
+    }
+    concurrent.sync_barrier([] {});
+
+    auto find = [&](const std::string& name) {
+        for (auto& queue : pool.stats().queues) {
+            if (queue.name == name)
+                return queue.executed;
+        }
+        return uint64_t(0);
+    };
+    REQUIRE(wait_until([&] { return find("stats_serial") == 100; }));
+    REQUIRE(wait_until([&] { return find("stats_concurrent") == 101; }));
+
+    pool.set_metrics_enabled(false);
+}
+
+TEST_CASE("Queue set_target funnels serial queues through one parent", "[Queue]") {
+    constexpr int kChildren = 16;
+    constexpr int kTasks = 200;
+
+    Queue parent("target_parent", Queue::Type::Serial, ThreadPool::QoS::Utility);
+    std::vector<std::unique_ptr<Queue>> children;
+    std::vector<std::vector<int>> order(kChildren);
+    std::atomic<int> active{0};
+    std::atomic<int> max_active{0};
+    std::atomic<int> done{0};
+
+    for (int c = 0; c < kChildren; c++) {
+        children.push_back(std::make_unique<Queue>("target_child_" + std::to_string(c)));
+        children.back()->set_target(parent);
+    }
+    for (int i = 0; i < kTasks; i++) {
+        for (int c = 0; c < kChildren; c++) {
+            children[c]->async([&, c, i] {
+                int now = ++active;
+                int seen = max_active.load();
+                while (now > seen && !max_active.compare_exchange_weak(seen, now)) {}
+                order[c].push_back(i);
+                active--;
+                done++;
+            });
+        }
+    }
+
+    REQUIRE(wait_until([&] { return done.load() == kChildren * kTasks; }, 5000ms));
+    REQUIRE(max_active.load() == 1);
+    for (auto& child : order) {
+        REQUIRE(child.size() == kTasks);
+        REQUIRE(std::is_sorted(child.begin(), child.end()));
+    }
+}
+
+TEST_CASE("Queue set_target bounds a concurrent queue by its target", "[Queue]") {
+    Queue parent("target_serial_parent", Queue::Type::Serial, ThreadPool::QoS::Utility);
+    Queue child("target_concurrent_child", Queue::Type::Concurrent, ThreadPool::QoS::Utility);
+    child.set_target(parent);
+
+    std::atomic<int> active{0};
+    std::atomic<bool> overlapped{false};
+    std::atomic<int> done{0};
+    for (int i = 0; i < 200; i++) {
+        child.async([&] {
+            if (++active > 1)
+                overlapped = true;
+            active--;
+            done++;
+        });
+    }
+    child.sync_barrier([] {});
+
+    REQUIRE(done.load() == 200);
+    REQUIRE_FALSE(overlapped.load());
+}
+
+TEST_CASE("Queue set_target nests and can be reset", "[Queue]") {
+    Queue root("target_root", Queue::Type::Concurrent, ThreadPool::QoS::Utility);
+    Queue middle("target_middle", Queue::Type::Serial, ThreadPool::QoS::Utility);
+    Queue leaf("target_leaf", Queue::Type::Serial, ThreadPool::QoS::Utility);
+    middle.set_target(root);
+    leaf.set_target(middle);
+
+    std::vector<int> order;
+    std::atomic<int> done{0};
+    for (int i = 0; i < 100; i++) {
+        leaf.async([&, i] { order.push_back(i); done++; });
+    }
+    REQUIRE(wait_until([&] { return done.load() == 100; }));
+
+    leaf.reset_target();
+    leaf.async([&] { order.push_back(100); done++; });
+    REQUIRE(wait_until([&] { return done.load() == 101; }));
+
+    REQUIRE(order.size() == 101);
+    REQUIRE(std::is_sorted(order.begin(), order.end()));
+}
+
+TEST_CASE("Queue capacity blocks producers until tasks finish", "[Queue]") {
+    Queue sut("capacity_block", Queue::Type::Serial, ThreadPool::QoS::Utility);
+    sut.set_capacity(4);
+
+    std::atomic<bool> release{false};
+    std::atomic<int> submitted{0};
+    std::atomic<int> done{0};
+    std::thread producer([&] {
+        for (int i = 0; i < 10; i++) {
+            sut.async([&] {
+                while (!release.load()) {
+                    std::this_thread::sleep_for(1ms);
+                }
+                done++;
+            });
+            submitted++;
+        }
+    });
+
+    REQUIRE(wait_until([&] { return submitted.load() == 4; }));
+    std::this_thread::sleep_for(50ms);
+    REQUIRE(submitted.load() == 4);
+
+    release = true;
+    producer.join();
+    REQUIRE(wait_until([&] { return done.load() == 10; }));
+    REQUIRE(sut.rejected() == 0);
+}
+
+TEST_CASE("Queue try_async fails while the queue is full", "[Queue]") {
+    Queue sut("capacity_try", Queue::Type::Concurrent, ThreadPool::QoS::Utility);
+    sut.set_capacity(2);
+
+    std::atomic<bool> release{false};
+    std::atomic<int> done{0};
+    auto blocked = [&] {
+        while (!release.load()) {
+            std::this_thread::sleep_for(1ms);
+        }
+        done++;
+    };
+    REQUIRE(sut.try_async(blocked));
+    REQUIRE(sut.try_async(blocked));
+    REQUIRE_FALSE(sut.try_async([&] { done++; }));
+    REQUIRE(sut.rejected() == 1);
+
+    release = true;
+    REQUIRE(wait_until([&] { return done.load() == 2; }));
+    REQUIRE(wait_until([&] { return sut.try_async([&] { done++; }); }));
+    REQUIRE(wait_until([&] { return done.load() == 3; }));
+}
+
+TEST_CASE("Queue capacity drops the newest or the oldest tasks", "[Queue]") {
+    for (auto overflow : {ThreadPool::Overflow::DropNewest, ThreadPool::Overflow::DropOldest}) {
+        Queue sut("capacity_drop", Queue::Type::Serial, ThreadPool::QoS::Utility);
+        sut.set_capacity(4, overflow);
+
+        std::atomic<bool> started{false};
+        std::atomic<bool> release{false};
+        sut.async([&] {
+            started = true;
+            while (!release.load()) {
+                std::this_thread::sleep_for(1ms);
+            }
+        });
+        REQUIRE(wait_until([&] { return started.load(); }));
+
+        // Discarded tasks are released right away: the running task and
+        // three waiting ones are all the queue holds.
+        std::vector<int> ran;
+        auto held = std::make_shared<int>(0);
+        for (int i = 0; i < 10; i++) {
+            sut.async([&, i, held] { ran.push_back(i); });
+            REQUIRE(held.use_count() <= 4);
+        }
+        REQUIRE(sut.rejected() == 7);
+        REQUIRE(held.use_count() == 4);
+
+        // Barriers are not limited, so this one runs after whatever was kept.
+        std::atomic<bool> finished{false};
+        sut.async_barrier([&] { finished = true; });
+        release = true;
+        REQUIRE(wait_until([&] { return finished.load(); }));
+        if (overflow == ThreadPool::Overflow::DropNewest) {
+            REQUIRE(ran == std::vector<int>{0, 1, 2});
+        } else {
+            REQUIRE(ran == std::vector<int>{7, 8, 9});
+        }
+    }
+}
+
+TEST_CASE("Queue async_result reports dropped tasks as broken promises", "[Queue]") {
+    for (auto overflow : {ThreadPool::Overflow::DropNewest, ThreadPool::Overflow::DropOldest}) {
+        Queue sut("capacity_result", Queue::Type::Serial, ThreadPool::QoS::Utility);
+        sut.set_capacity(2, overflow);
+
+        std::atomic<bool> started{false};
+        std::atomic<bool> release{false};
+        sut.async([&] {
+            started = true;
+            while (!release.load()) {
+                std::this_thread::sleep_for(1ms);
+            }
+        });
+        REQUIRE(wait_until([&] { return started.load(); }));
+        auto first = sut.async_result([] { return 1; });
+        auto second = sut.async_result([] { return 2; });
+        REQUIRE(sut.rejected() == 1);
+
+        // DropNewest refuses the second task, DropOldest discards the first.
+        auto& dropped = overflow == ThreadPool::Overflow::DropNewest ? second : first;
+        auto& kept = overflow == ThreadPool::Overflow::DropNewest ? first : second;
+        REQUIRE(dropped.ready());
+        try {
+            dropped.get();
+            FAIL("dropped task produced a result");
+        } catch (const std::future_error& error) {
+            REQUIRE(error.code() == std::future_errc::broken_promise);
+        }
+
+        release = true;
+        REQUIRE(kept.get() == (overflow == ThreadPool::Overflow::DropNewest ? 1 : 2));
+    }
+}
+
+#if defined(__cpp_impl_coroutine)
+static task<void> bump(std::atomic<int>& counter) {
+    counter++;
+    co_return;
+}
+#endif
+
+TEST_CASE("Queue capacity does not limit runs submitted by the library", "[Queue]") {
+    Queue sut("capacity_internal", Queue::Type::Serial, ThreadPool::QoS::Utility);
+    sut.set_capacity(1, ThreadPool::Overflow::DropNewest);
+
+    std::atomic<bool> release{false};
+    sut.async([&] {
+        while (!release.load()) {
+            std::this_thread::sleep_for(1ms);
+        }
+    });
+    REQUIRE_FALSE(sut.try_async([] {}));
+
+    // Each of these would be refused by async() while the queue is full.
+    std::atomic<uint64_t> merged{0};
+    std::atomic<int> ran{0};
+    {
+        Source source(sut, Source::Merge::Add, [&](uint64_t data) { merged += data; });
+        source.merge(3);
+
+        Timer::instance().schedule([&] { ran++; }, std::chrono::steady_clock::now(), sut);
+
+        Group group;
+        group.notify(sut, [&] { ran++; });
+
+        auto promise = Queue::global(ThreadPool::QoS::Utility).async_result([] { return 2; });
+        auto next = promise.then(sut, [&](int value) { ran += value; });
+        int expected = 4;
+
+#if defined(__cpp_impl_coroutine)
+        // spawn() resumes the coroutine through schedule().
+        auto resumed = spawn(sut, bump(ran));
+        expected++;
+#endif
+
+        release = true;
+        REQUIRE(wait_until([&] { return merged.load() == 3 && ran.load() == expected; }));
+        next.get();
+#if defined(__cpp_impl_coroutine)
+        resumed.get();
+#endif
+    }
+    REQUIRE(sut.rejected() == 1);
+}
@@ -0,0 +1,250 @@
+#include <catch2/catch_test_macros.hpp>
+#include <TurboQ/reactor.hpp>
+#include <TurboQ/queue.hpp>
+#include "test_helpers.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+
+#if defined(__linux__)
+#include <fcntl.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+using namespace turboq;
+using namespace test_helpers;
+using namespace std::chrono_literals;
+
+#if defined(__linux__)
+
+namespace {
+
+void set_nonblocking(int fd) {
+    fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+}
+
+// Reads until the descriptor would block, as edge-triggered handlers must.
+size_t drain(int fd) {
+    char buffer[256];
+    size_t total = 0;
+    while (true) {
+        ssize_t n = ::read(fd, buffer, sizeof(buffer));
+        if (n <= 0)
+            return total;
+        total += static_cast<size_t>(n);
+    }
+}
+
+} // namespace
+
+TEST_CASE("Reactor delivers pipe readiness onto a queue", "[Reactor]") {
+    REQUIRE(Reactor::supported());
+
+    int fds[2];
+    REQUIRE(::pipe(fds) == 0);
+    set_nonblocking(fds[0]);
+
+    Reactor reactor;
+    Queue queue("reactor_pipe", Queue::Type::Serial, ThreadPool::QoS::Utility);
+    std::atomic<size_t> received{0};
+    std::atomic<bool> hangup{false};
+
+    auto handle = reactor.watch(fds[0], Reactor::Read, queue, [&](uint32_t events) {
+        if (events & Reactor::Read)
+            received += drain(fds[0]);
+        if (events & Reactor::Hangup)
+            hangup = true;
+    });
+    REQUIRE(handle);
+    REQUIRE(handle.active());
+
+    for (int i = 0; i < 100; i++) {
+        REQUIRE(::write(fds[1], "0123456789", 10) == 10);
+    }
+    REQUIRE(wait_until([&] { return received.load() == 1000; }));
+
+    ::close(fds[1]);
+    REQUIRE(wait_until([&] { return hangup.load(); }));
+
+    REQUIRE(handle.cancel());
+    REQUIRE_FALSE(handle.active());
+    REQUIRE_FALSE(handle.cancel());
+    ::close(fds[0]);
+}
+
+TEST_CASE("Reactor reports socketpair write readiness and runs handlers one at a time", "[Reactor]") {
+    int fds[2];
+    REQUIRE(::socketpair(AF_UNIX, SOCK_STREAM, 0, fds) == 0);
+    set_nonblocking(fds[0]);
+    set_nonblocking(fds[1]);
+
+    Reactor reactor;
+    Queue queue("reactor_socket", Queue::Type::Concurrent, ThreadPool::QoS::Utility);
+    std::atomic<bool> writable{false};
+    std::atomic<size_t> received{0};
+    std::atomic<int> active{0};
+    std::atomic<bool> overlapped{false};
+
+    auto writer = reactor.watch(fds[0], Reactor::Write, queue, [&](uint32_t events) {
+        if (events & Reactor::Write)
+            writable = true;
+    });
+    auto reader = reactor.watch(fds[1], Reactor::Read, queue, [&](uint32_t) {
+        if (++active > 1)
+            overlapped = true;
+        std::this_thread::sleep_for(1ms);
+        received += drain(fds[1]);
+        active--;
+    });
+    REQUIRE(writer);
+    REQUIRE(reader);
+    REQUIRE(wait_until([&] { return writable.load(); }));
+
+    std::string chunk(64, 'x');
+    for (int i = 0; i < 200; i++) {
+        REQUIRE(::write(fds[0], chunk.data(), chunk.size()) == static_cast<ssize_t>(chunk.size()));
+    }
+    REQUIRE(wait_until([&] { return received.load() == 200 * chunk.size(); }));
+    REQUIRE_FALSE(overlapped.load());
+
+    writer.cancel();
+    reader.cancel();
+    ::close(fds[0]);
+    ::close(fds[1]);
+}
+
+TEST_CASE("Reactor reports hangups to write-only watches without Read", "[Reactor]") {
+    int fds[2];
+    REQUIRE(::socketpair(AF_UNIX, SOCK_STREAM, 0, fds) == 0);
+    set_nonblocking(fds[0]);
+
+    Reactor reactor;
+    Queue queue("reactor_write_only", Queue::Type::Serial, ThreadPool::QoS::Utility);
+    std::atomic<bool> writable{false};
+    std::atomic<bool> read{false};
+    std::atomic<bool> hangup{false};
+
+    auto writer = reactor.watch(fds[0], Reactor::Write, queue, [&](uint32_t events) {
+        if (events & Reactor::Write)
+            writable = true;
+        if (events & Reactor::Read)
+            read = true;
+        if (events & (Reactor::Hangup | Reactor::Error))
+            hangup = true;
+    });
+    REQUIRE(writer);
+    REQUIRE(wait_until([&] { return writable.load(); }));
+
+    // The peer stops writing: nothing for a writer to act on.
+    REQUIRE(::shutdown(fds[1], SHUT_WR) == 0);
+    std::this_thread::sleep_for(20ms);
+    REQUIRE_FALSE(hangup.load());
+
+    ::close(fds[1]);
+    REQUIRE(wait_until([&] { return hangup.load(); }));
+    REQUIRE_FALSE(read.load());
+
+    writer.cancel();
+    ::close(fds[0]);
+}
+
+TEST_CASE("Reactor watches eventfd and stops after cancel", "[Reactor]") {
+    int fd = eventfd(0, EFD_NONBLOCK);
+    REQUIRE(fd >= 0);
+
+    Reactor reactor;
+    Queue queue("reactor_eventfd", Queue::Type::Serial, ThreadPool::QoS::Utility);
+    std::atomic<uint64_t> total{0};
+    std::atomic<int> runs{0};
+
+    auto handle = reactor.watch(fd, Reactor::Read, queue, [&](uint32_t) {
+        uint64_t value;
+        if (::read(fd, &value, sizeof(value)) == sizeof(value))
+            total += value;
+        runs++;
+    });
+    REQUIRE(handle);
+
+    // The same descriptor cannot be registered twice.
+    REQUIRE_FALSE(reactor.watch(fd, Reactor::Read, queue, [](uint32_t) {}));
+
+    uint64_t one = 1;
+    for (int i = 0; i < 10; i++) {
+        REQUIRE(::write(fd, &one, sizeof(one)) == sizeof(one));
+    }
+    REQUIRE(wait_until([&] { return total.load() == 10; }));
+
+    handle.cancel();
+    int seen = runs.load();
+    REQUIRE(::write(fd, &one, sizeof(one)) == sizeof(one));
+    std::this_thread::sleep_for(20ms);
+    REQUIRE(runs.load() == seen);
+    ::close(fd);
+}
+
+TEST_CASE("Reactor handle outlives its reactor", "[Reactor]") {
+    int fd = eventfd(0, EFD_NONBLOCK);
+    REQUIRE(fd >= 0);
+
+    auto reactor = std::make_unique<Reactor>();
+    Queue queue("reactor_gone", Queue::Type::Serial, ThreadPool::QoS::Utility);
+    auto handle = reactor->watch(fd, Reactor::Read, queue, [](uint32_t) {});
+    REQUIRE(handle.active());
+
+    reactor.reset();
+    REQUIRE_FALSE(handle.active());
+    REQUIRE_FALSE(handle.cancel());
+    ::close(fd);
+}
+
+TEST_CASE("Reactor changes registrations while a run waits for the queue", "[Reactor]") {
+    int fd = eventfd(0, EFD_NONBLOCK);
+    int other = eventfd(0, EFD_NONBLOCK);
+    REQUIRE(fd >= 0);
+    REQUIRE(other >= 0);
+
+    Reactor reactor;
+    Queue queue("reactor_full", Queue::Type::Serial, ThreadPool::QoS::Utility);
+    queue.set_capacity(1);
+    std::atomic<bool> open{false};
+    std::atomic<int> runs{0};
+
+    // The queue is full until the gate opens.
+    queue.async([&] {
+        while (!open.load()) {
+            std::this_thread::sleep_for(1ms);
+        }
+    });
+    auto handle = reactor.watch(fd, Reactor::Read, queue, [&](uint32_t) {
+        uint64_t value;
+        [[maybe_unused]] auto read = ::read(fd, &value, sizeof(value));
+        runs++;
+    });
+    REQUIRE(handle);
+
+    uint64_t one = 1;
+    REQUIRE(::write(fd, &one, sizeof(one)) == sizeof(one));
+    std::this_thread::sleep_for(20ms);
+
+    std::atomic<bool> watched{false};
+    std::thread watcher([&] {
+        auto registration = reactor.watch(other, Reactor::Read, queue, [](uint32_t) {});
+        watched = registration.cancel();
+    });
+    bool done = wait_until([&] { return watched.load(); });
+    open = true;
+    watcher.join();
+
+    REQUIRE(done);
+    REQUIRE(wait_until([&] { return runs.load() == 1; }));
+    handle.cancel();
+    ::close(fd);
+    ::close(other);
+}
+
+#endif
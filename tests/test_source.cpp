@@ -0,0 +1,157 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <TurboQ/source.hpp>
+#include <TurboQ/queue.hpp>
+#include "test_helpers.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace turboq;
+using namespace test_helpers;
+using namespace std::chrono_literals;
+
+namespace {
+
+// Holds a serial queue busy so that merges pile up behind it.
+struct Gate {
+    std::atomic<bool> open{false};
+
+    void close(Queue& queue) {
+        std::atomic<bool> entered{false};
+        queue.async([this, &entered] {
+            entered = true;
+            while (!open.load()) {
+                std::this_thread::sleep_for(1ms);
+            }
+        });
+        while (!entered.load()) {
+            std::this_thread::yield();
+        }
+    }
+};
+
+} // namespace
+
+TEST_CASE("Source Add delivers every merged count", "[Source]") {
+    constexpr int kThreads = 4;
+    constexpr int kSignals = 100000;
+
+    Queue queue("source_add", Queue::Type::Concurrent, ThreadPool::QoS::Utility);
+    std::atomic<uint64_t> total{0};
+    std::atomic<int> runs{0};
+    std::atomic<int> active{0};
+    std::atomic<bool> overlapped{false};
+
+    Source source(queue, Source::Merge::Add, [&](uint64_t data) {
+        if (++active > 1)
+            overlapped = true;
+        total += data;
+        runs++;
+        active--;
+    });
+
+    std::vector<std::thread> producers;
+    for (int t = 0; t < kThreads; t++) {
+        producers.emplace_back([&] {
+            for (int i = 0; i < kSignals; i++) {
+                source.merge(1);
+            }
+        });
+    }
+    for (auto& producer : producers) {
+        producer.join();
+    }
+
+    REQUIRE(wait_until([&] { return total.load() == uint64_t(kThreads) * kSignals; }, 5000ms));
+    REQUIRE(runs.load() <= kThreads * kSignals);
+    REQUIRE_FALSE(overlapped.load());
+}
+
+TEST_CASE("Source Or and Replace coalesce pending data into one run", "[Source]") {
+    Queue queue("source_merge", Queue::Type::Serial, ThreadPool::QoS::Utility);
+    std::vector<uint64_t> flags, latest;
+    std::atomic<int> runs{0};
+
+    Source or_source(queue, Source::Merge::Or, [&](uint64_t data) { flags.push_back(data); runs++; });
+    Source replace_source(queue, Source::Merge::Replace, [&](uint64_t data) { latest.push_back(data); runs++; });
+
+    Gate gate;
+    gate.close(queue);
+    or_source.merge(1);
+    or_source.merge(2);
+    or_source.merge(4);
+    or_source.merge(0);
+    replace_source.merge(5);
+    replace_source.merge(9);
+    gate.open = true;
+
+    std::atomic<bool> flushed{false};
+    queue.async([&] { flushed = true; });
+    REQUIRE(wait_until([&] { return flushed.load(); }));
+    REQUIRE(runs.load() == 2);
+    REQUIRE(flags == std::vector<uint64_t>{7});
+    REQUIRE(latest == std::vector<uint64_t>{9});
+}
+
+TEST_CASE("Source cancel drops pending data", "[Source]") {
+    Queue queue("source_cancel", Queue::Type::Serial, ThreadPool::QoS::Utility);
+    std::atomic<int> runs{0};
+    std::atomic<bool> flushed{false};
+
+    Source source(queue, Source::Merge::Add, [&](uint64_t) { runs++; });
+
+    Gate gate;
+    gate.close(queue);
+    source.merge(3);
+    source.cancel();
+    source.merge(4);
+    queue.async([&] { flushed = true; });
+    gate.open = true;
+
+    REQUIRE(wait_until([&] { return flushed.load(); }));
+    REQUIRE(source.cancelled());
+    REQUIRE(runs.load() == 0);
+}
+
+TEST_CASE("Source keeps delivering after the handler throws", "[Source]") {
+    Queue queue("source_throw", Queue::Type::Serial, ThreadPool::QoS::Utility);
+    std::atomic<int> runs{0};
+
+    Source source(queue, Source::Merge::Add, [&](uint64_t) {
+        if (runs++ == 0)
+            throw std::runtime_error("handler failed");
+    });
+
+    source.merge(1);
+    REQUIRE(wait_until([&] { return runs.load() == 1; }));
+    source.merge(1);
+    REQUIRE(wait_until([&] { return runs.load() == 2; }));
+}
+
+TEST_CASE("Source merge against one async per signal", "[.][benchmark][Source]") {
+    constexpr int kSignals = 100000;
+    Queue queue("source_bench", Queue::Type::Serial, ThreadPool::QoS::Utility);
+
+    BENCHMARK("async per signal") {
+        std::atomic<int> handled{0};
+        for (int i = 0; i < kSignals; i++) {
+            queue.async([&] { handled++; });
+        }
+        while (handled.load() != kSignals) std::this_thread::yield();
+        return handled.load();
+    };
+
+    BENCHMARK("Source::merge") {
+        std::atomic<uint64_t> handled{0};
+        Source source(queue, Source::Merge::Add, [&](uint64_t data) { handled += data; });
+        for (int i = 0; i < kSignals; i++) {
+            source.merge(1);
+        }
+        while (handled.load() != kSignals) std::this_thread::yield();
+        return handled.load();
+    };
+}
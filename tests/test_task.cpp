@@ -0,0 +1,97 @@
+#include <catch2/catch_test_macros.hpp>
+#include <TurboQ/task.hpp>
+#include <TurboQ/thread_pool.hpp>
+#include "test_helpers.hpp"
+
+#include <array>
+#include <atomic>
+#include <cstdlib>
+#include <memory>
+#include <new>
+
+using namespace turboq;
+
+void* operator new(std::size_t size) {
+    test_helpers::allocations++;
+    if (void* p = std::malloc(size ? size : 1))
+        return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept {
+    std::free(p);
+}
+
+TEST_CASE("Task stores small captures without allocating", "[Task]") {
+    std::array<char, 48> payload{};
+    int calls = 0;
+
+    size_t before = test_helpers::allocations;
+    Task sut([payload, &calls] { calls += payload[0] + 1; });
+    Task moved(std::move(sut));
+    moved();
+    size_t after = test_helpers::allocations;
+
+    REQUIRE(after == before);
+    REQUIRE(calls == 1);
+    REQUIRE_FALSE(sut);
+    REQUIRE(moved);
+}
+
+TEST_CASE("Task accepts move-only captures", "[Task]") {
+    auto value = std::make_unique<int>(42);
+    int result = 0;
+
+    Task sut([value = std::move(value), &result] { result = *value; });
+    sut();
+
+    REQUIRE(result == 42);
+}
+
+TEST_CASE("Task falls back to the heap for large captures", "[Task]") {
+    std::array<char, 512> payload{};
+    payload[511] = 7;
+    int result = 0;
+
+    Task sut([payload, &result] { result = payload[511]; });
+    Task moved = std::move(sut);
+    moved();
+
+    REQUIRE(result == 7);
+}
+
+TEST_CASE("Task destroys its callable", "[Task]") {
+    auto value = std::make_shared<int>(0);
+    {
+        Task sut([value] {});
+        REQUIRE(value.use_count() == 2);
+    }
+    REQUIRE(value.use_count() == 1);
+}
+
+TEST_CASE("ThreadPool runs tasks with move-only captures", "[Task]") {
+    ThreadPool pool(2);
+    std::atomic<int> result{0};
+    auto value = std::make_unique<int>(7);
+
+    pool.submit([value = std::move(value), &result] { result = *value; });
+
+    REQUIRE(test_helpers::wait_until([&]{ return result.load() == 7; }));
+}
+
+TEST_CASE("ThreadPool submit does not allocate for inline tasks", "[Task]") {
+    ThreadPool pool(1);
+    std::atomic<int> counter{0};
+    Task task([&counter] { counter++; });
+
+    size_t before = test_helpers::allocations;
+    pool.submit(std::move(task));
+    size_t after = test_helpers::allocations;
+
+    REQUIRE(after == before);
+    REQUIRE(test_helpers::wait_until([&]{ return counter.load() == 1; }));
+}
@@ -1,10 +1,17 @@
 #include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
 #include <TurboQ/thread_pool.hpp>
+#include <TurboQ/detail/topology.hpp>
 #include "test_helpers.hpp"
 
+#include <algorithm>
 #include <atomic>
 #include <chrono>
+#include <memory>
+#include <mutex>
 #include <thread>
+#include <utility>
+#include <vector>
 
 using namespace turboq;
 using namespace std::chrono_literals;
@@ -65,3 +72,632 @@ TEST_CASE("ThreadPool prioritizes higher QoS over lower QoS in long run", "[Thre
 
     REQUIRE(violations <= 10);
 }
+
+TEST_CASE("ThreadPool work-stealing executes tasks", "[ThreadPool]") {
+    ThreadPool::Options options;
+    options.threads = 4;
+    options.scheduler = ThreadPool::Scheduler::WorkStealing;
+    ThreadPool sut(options);
+
+    std::atomic<int> counter{0};
+
+    for (int i = 0; i < 100; i++) {
+        sut.submit([&]{ counter++; });
+    }
+
+    REQUIRE(test_helpers::wait_until([&]{ return counter == 100; }));
+}
+
+TEST_CASE("ThreadPool work-stealing runs tasks submitted from workers", "[ThreadPool]") {
+    ThreadPool::Options options;
+    options.threads = 4;
+    options.scheduler = ThreadPool::Scheduler::WorkStealing;
+    ThreadPool sut(options);
+
+    std::atomic<int> counter{0};
+
+    for (int i = 0; i < 10; i++) {
+        sut.submit([&]{
+            for (int j = 0; j < 10; j++) {
+                sut.submit([&]{ counter++; });
+            }
+        });
+    }
+
+    REQUIRE(test_helpers::wait_until([&]{ return counter == 100; }));
+}
+
+TEST_CASE("ThreadPool work-stealing prioritizes higher QoS", "[ThreadPool]") {
+    ThreadPool::Options options;
+    options.threads = 1;
+    options.scheduler = ThreadPool::Scheduler::WorkStealing;
+    ThreadPool sut(options);
+
+    std::vector<ThreadPool::QoS> executed;
+    std::mutex m;
+    std::atomic<bool> release{false};
+
+    // Keep the only worker busy until every task is queued.
+    sut.submit([&]{ while (!release) std::this_thread::yield(); }, ThreadPool::QoS::UserInteractive);
+
+    sut.submit([&]{ std::lock_guard<std::mutex> lock(m); executed.push_back(ThreadPool::QoS::Background); }, ThreadPool::QoS::Background);
+    sut.submit([&]{ std::lock_guard<std::mutex> lock(m); executed.push_back(ThreadPool::QoS::Utility); }, ThreadPool::QoS::Utility);
+    sut.submit([&]{ std::lock_guard<std::mutex> lock(m); executed.push_back(ThreadPool::QoS::UserInteractive); }, ThreadPool::QoS::UserInteractive);
+    sut.submit([&]{ std::lock_guard<std::mutex> lock(m); executed.push_back(ThreadPool::QoS::UserInitiated); }, ThreadPool::QoS::UserInitiated);
+
+    release = true;
+
+    REQUIRE(test_helpers::wait_until([&]{
+        std::lock_guard<std::mutex> lock(m);
+        return executed.size() == 4;
+    }));
+
+    REQUIRE(executed[0] == ThreadPool::QoS::UserInteractive);
+    REQUIRE(executed[1] == ThreadPool::QoS::UserInitiated);
+    REQUIRE(executed[2] == ThreadPool::QoS::Utility);
+    REQUIRE(executed[3] == ThreadPool::QoS::Background);
+}
+
+TEST_CASE("ThreadPool keeps tasks that overflow the QoS ring", "[ThreadPool]") {
+    ThreadPool::Options options;
+    options.threads = 1;
+    options.ring_capacity = 4;
+    ThreadPool sut(options);
+
+    std::atomic<bool> release{false};
+    std::atomic<int> counter{0};
+
+    sut.submit([&]{ while (!release) std::this_thread::yield(); });
+    for (int i = 0; i < 100; i++) {
+        sut.submit([&]{ counter++; }, ThreadPool::QoS::Background);
+    }
+    release = true;
+
+    REQUIRE(test_helpers::wait_until([&]{ return counter == 100; }));
+}
+
+TEST_CASE("ThreadPool scheduler throughput", "[.][benchmark][ThreadPool]") {
+    constexpr int tasks = 10000;
+
+    auto run = [](ThreadPool& pool) {
+        std::atomic<int> counter{0};
+        // Fan out from inside the pool so that work-stealing can use local deques.
+        for (size_t w = 0; w < pool.size(); w++) {
+            pool.submit([&] {
+                for (int i = 0; i < tasks; i++) {
+                    pool.submit([&]{ counter++; });
+                }
+            });
+        }
+        const int expected = tasks * static_cast<int>(pool.size());
+        while (counter.load() != expected) {
+            std::this_thread::yield();
+        }
+        return counter.load();
+    };
+
+    ThreadPool::Options options;
+
+    options.scheduler = ThreadPool::Scheduler::GlobalQueue;
+    ThreadPool global(options);
+    BENCHMARK("GlobalQueue") { return run(global); };
+
+    options.scheduler = ThreadPool::Scheduler::WorkStealing;
+    ThreadPool stealing(options);
+    BENCHMARK("WorkStealing") { return run(stealing); };
+}
+
+TEST_CASE("ThreadPool submit_bulk executes every task", "[ThreadPool]") {
+    for (auto scheduler : {ThreadPool::Scheduler::GlobalQueue, ThreadPool::Scheduler::WorkStealing}) {
+        ThreadPool::Options options;
+        options.threads = 4;
+        options.scheduler = scheduler;
+        options.ring_capacity = 64;
+        ThreadPool sut(options);
+
+        std::atomic<int> counter{0};
+        std::vector<ThreadPool::Task> tasks;
+        for (int i = 0; i < 1000; i++) {
+            tasks.emplace_back([&]{ counter++; });
+        }
+
+        sut.submit_bulk(tasks, ThreadPool::QoS::UserInitiated);
+
+        REQUIRE(test_helpers::wait_until([&]{ return counter == 1000; }));
+    }
+}
+
+TEST_CASE("ThreadPool stats count executed tasks per QoS", "[ThreadPool]") {
+    ThreadPool sut(2);
+    std::atomic<int> counter{0};
+
+    for (int i = 0; i < 100; i++) {
+        sut.submit([&]{ counter++; }, ThreadPool::QoS::UserInitiated);
+    }
+    sut.submit([&]{ counter++; }, ThreadPool::QoS::Background);
+
+    REQUIRE(test_helpers::wait_until([&]{
+        auto stats = sut.stats();
+        return stats.levels[static_cast<size_t>(ThreadPool::QoS::UserInitiated)].executed == 100 &&
+               stats.levels[static_cast<size_t>(ThreadPool::QoS::Background)].executed == 1;
+    }));
+
+    auto stats = sut.stats();
+    REQUIRE(stats.levels[static_cast<size_t>(ThreadPool::QoS::UserInitiated)].depth == 0);
+    REQUIRE(stats.levels[static_cast<size_t>(ThreadPool::QoS::UserInitiated)].run.count() == 0);
+    REQUIRE(stats.queues.empty());
+}
+
+TEST_CASE("ThreadPool stats sample latency histograms", "[ThreadPool]") {
+    ThreadPool::Options options;
+    options.threads = 1;
+    options.metrics = true;
+    ThreadPool sut(options);
+    std::atomic<bool> release{false};
+    std::atomic<int> counter{0};
+    constexpr int tasks = 320;
+    constexpr size_t utility = static_cast<size_t>(ThreadPool::QoS::Utility);
+
+    sut.submit([&]{ while (!release) std::this_thread::yield(); }, ThreadPool::QoS::Utility);
+    for (int i = 0; i < tasks; i++) {
+        sut.submit([&]{ counter++; }, ThreadPool::QoS::Utility);
+    }
+
+    REQUIRE(test_helpers::wait_until([&]{ return sut.stats().levels[utility].depth == tasks; }));
+    std::this_thread::sleep_for(2ms);
+    release = true;
+
+    REQUIRE(test_helpers::wait_until([&]{ return sut.stats().levels[utility].executed == tasks + 1; }));
+    REQUIRE(test_helpers::wait_until([&]{ return counter == tasks; }));
+
+    // Histograms are updated after each task returns.
+    REQUIRE(test_helpers::wait_until([&]{
+        auto stats = sut.stats();
+        auto& level = stats.levels[utility];
+        return level.wait.count() >= tasks / 32 && level.run.count() == level.wait.count();
+    }));
+
+    auto stats = sut.stats();
+    REQUIRE(stats.levels[utility].depth == 0);
+    REQUIRE(stats.levels[utility].wait.percentile(0.5) >= 1ms);
+}
+
+TEST_CASE("ThreadPool parses CPU lists", "[ThreadPool]") {
+    using detail::parse_cpu_list;
+
+    REQUIRE(parse_cpu_list("0") == std::vector<int>{0});
+    REQUIRE(parse_cpu_list("0-3,8,10-11\n") == std::vector<int>{0, 1, 2, 3, 8, 10, 11});
+    REQUIRE(parse_cpu_list("4,2,2-3") == std::vector<int>{2, 3, 4});
+    REQUIRE(parse_cpu_list("").empty());
+}
+
+TEST_CASE("ThreadPool detects at least one node of allowed CPUs", "[ThreadPool]") {
+    auto allowed = detail::allowed_cpus();
+    auto topology = detail::detect_topology();
+
+    REQUIRE_FALSE(topology.nodes.empty());
+    for (const auto& node : topology.nodes) {
+        REQUIRE_FALSE(node.empty());
+        for (int cpu : node) {
+            REQUIRE(std::find(allowed.begin(), allowed.end(), cpu) != allowed.end());
+        }
+    }
+}
+
+#if defined(__linux__)
+TEST_CASE("ThreadPool pins workers to the requested CPUs", "[ThreadPool]") {
+    const int cpu = detail::allowed_cpus().front();
+
+    ThreadPool::Options options;
+    options.threads = 2;
+    options.affinity = ThreadPool::Affinity::Core;
+    options.cpus = {cpu};
+    ThreadPool sut(options);
+
+    std::atomic<int> done{0};
+    std::atomic<bool> misplaced{false};
+    for (int i = 0; i < 100; i++) {
+        sut.submit([&]{
+            if (detail::current_cpu() != cpu)
+                misplaced = true;
+            done++;
+        });
+    }
+
+    REQUIRE(test_helpers::wait_until([&]{ return done == 100; }));
+    REQUIRE_FALSE(misplaced);
+}
+#endif
+
+TEST_CASE("ThreadPool with NUMA sub-pools executes every task", "[ThreadPool]") {
+    for (auto scheduler : {ThreadPool::Scheduler::GlobalQueue, ThreadPool::Scheduler::WorkStealing}) {
+        ThreadPool::Options options;
+        options.threads = 4;
+        options.scheduler = scheduler;
+        options.numa = true;
+        options.affinity = ThreadPool::Affinity::Node;
+        ThreadPool sut(options);
+
+        std::atomic<int> counter{0};
+        for (int i = 0; i < 1000; i++) {
+            sut.submit([&]{ counter++; }, ThreadPool::QoS::Utility);
+        }
+        sut.submit([&]{
+            for (int i = 0; i < 1000; i++) {
+                sut.submit([&]{ counter++; }, ThreadPool::QoS::Background);
+            }
+        });
+
+        REQUIRE(test_helpers::wait_until([&]{ return counter == 2000; }));
+    }
+}
+
+TEST_CASE("ThreadPool wakes parked and polling workers", "[ThreadPool]") {
+    for (size_t spin : {size_t(0), size_t(1u << 20)}) {
+        ThreadPool::Options options;
+        options.threads = 2;
+        options.spin_count = spin;
+        options.yield_count = 0;
+        ThreadPool sut(options);
+        std::atomic<int> counter{0};
+
+        for (int round = 1; round <= 20; round++) {
+            sut.submit([&]{ counter++; });
+            REQUIRE(test_helpers::wait_until([&]{ return counter == round; }));
+            if (round % 5 == 0)
+                std::this_thread::sleep_for(5ms);
+        }
+
+        std::vector<ThreadPool::Task> burst;
+        for (int i = 0; i < 100; i++) {
+            burst.emplace_back([&]{ counter++; });
+        }
+        sut.submit_bulk(burst);
+        REQUIRE(test_helpers::wait_until([&]{ return counter == 120; }));
+    }
+}
+
+TEST_CASE("EventCount does not lose a notification", "[ThreadPool]") {
+    detail::EventCount events;
+    std::atomic<bool> flag{false};
+    std::atomic<bool> woke{false};
+
+    std::thread waiter([&]{
+        while (!flag.load()) {
+            auto key = events.prepare_wait();
+            if (flag.load()) {
+                events.cancel_wait();
+                break;
+            }
+            events.wait(key);
+        }
+        woke = true;
+    });
+
+    REQUIRE(test_helpers::wait_until([&]{ return events.waiters() == 1; }));
+    flag = true;
+    events.notify(1);
+    waiter.join();
+
+    REQUIRE(woke);
+    REQUIRE(events.waiters() == 0);
+
+    auto key = events.prepare_wait();
+    REQUIRE_FALSE(events.wait_until(key, std::chrono::steady_clock::now() + 1ms));
+}
+
+TEST_CASE("ThreadPool BlockingScope starts a replacement worker", "[ThreadPool]") {
+    for (auto scheduler : {ThreadPool::Scheduler::GlobalQueue, ThreadPool::Scheduler::WorkStealing}) {
+        ThreadPool::Options options;
+        options.threads = 1;
+        options.max_threads = 4;
+        options.scheduler = scheduler;
+        options.spawn_after = 10s;
+        ThreadPool pool(options);
+        REQUIRE(pool.size() == 1);
+
+        // The only core worker waits on a task queued behind it.
+        std::atomic<bool> released{false};
+        std::atomic<bool> done{false};
+        pool.submit([&] {
+            pool.submit([&] { released = true; });
+            ThreadPool::BlockingScope blocking;
+            while (!released.load()) {
+                std::this_thread::sleep_for(1ms);
+            }
+            done = true;
+        });
+
+        REQUIRE(test_helpers::wait_until([&]{ return done.load(); }));
+        REQUIRE(pool.size() == 2);
+    }
+}
+
+TEST_CASE("ThreadPool grows when saturated and shrinks when idle", "[ThreadPool]") {
+    ThreadPool::Options options;
+    options.threads = 1;
+    options.max_threads = 2;
+    options.spawn_after = 5ms;
+    options.idle_timeout = 50ms;
+    ThreadPool pool(options);
+
+    std::atomic<bool> release{false};
+    std::atomic<bool> second{false};
+    auto saturate = [&] {
+        release = false;
+        second = false;
+        pool.submit([&] {
+            while (!release.load()) {
+                std::this_thread::sleep_for(1ms);
+            }
+        });
+        pool.submit([&] { second = true; });
+
+        REQUIRE(test_helpers::wait_until([&]{ return second.load(); }));
+        REQUIRE(pool.size() == 2);
+        release = true;
+
+        REQUIRE(test_helpers::wait_until([&]{ return pool.size() == 1; }));
+    };
+
+    saturate();
+    // The supervisor sleeps while nothing is queued and wakes for the next burst.
+    std::this_thread::sleep_for(20ms);
+    saturate();
+
+    std::atomic<int> counter{0};
+    for (int i = 0; i < 100; i++) {
+        pool.submit([&]{ counter++; });
+    }
+    REQUIRE(test_helpers::wait_until([&]{ return counter.load() == 100; }));
+}
+
+TEST_CASE("ThreadPool BlockingScope is a no-op outside elastic pools", "[ThreadPool]") {
+    ThreadPool::Options options;
+    options.threads = 1;
+    ThreadPool pool(options);
+
+    ThreadPool::BlockingScope outside;
+    std::atomic<bool> done{false};
+    pool.submit([&] {
+        ThreadPool::BlockingScope blocking;
+        done = true;
+    });
+    REQUIRE(test_helpers::wait_until([&]{ return done.load(); }));
+    REQUIRE(pool.size() == 1);
+}
+
+TEST_CASE("ThreadPool fair policy bounds lower QoS latency under overload", "[ThreadPool]") {
+    using Clock = std::chrono::steady_clock;
+    constexpr int kHigh = 2000;
+    constexpr int kLow = 200;
+
+    for (auto scheduler : {ThreadPool::Scheduler::GlobalQueue, ThreadPool::Scheduler::WorkStealing}) {
+        ThreadPool::Options options;
+        options.threads = 1;
+        options.scheduler = scheduler;
+        options.ring_capacity = 64;
+        options.policy = ThreadPool::Policy::Fair;
+        ThreadPool pool(options);
+
+        struct Run {
+            int id;
+            size_t position;
+            Clock::duration latency;
+        };
+        std::vector<Run> high, low;
+        size_t position = 0;
+        std::atomic<int> done{0};
+
+        // Hold the only worker until the whole backlog is queued.
+        std::atomic<bool> started{false};
+        std::atomic<bool> release{false};
+        pool.submit([&] {
+            started = true;
+            while (!release.load()) {
+                std::this_thread::yield();
+            }
+        }, ThreadPool::QoS::UserInteractive);
+        REQUIRE(test_helpers::wait_until([&]{ return started.load(); }));
+
+        auto submit = [&](std::vector<Run>& runs, int id, ThreadPool::QoS qos) {
+            auto queued = Clock::now();
+            pool.submit([&runs, &position, &done, id, queued] {
+                runs.push_back(Run{id, position++, Clock::now() - queued});
+                done++;
+            }, qos);
+        };
+        for (int i = 0; i < kHigh; i++) {
+            submit(high, i, ThreadPool::QoS::UserInitiated);
+            if (i % (kHigh / kLow) == 0)
+                submit(low, i / (kHigh / kLow), ThreadPool::QoS::Background);
+        }
+        release = true;
+        REQUIRE(test_helpers::wait_until([&]{ return done.load() == kHigh + kLow; }, 10s));
+
+        // FIFO within each level.
+        for (auto* runs : {&high, &low}) {
+            for (size_t i = 0; i < runs->size(); i++) {
+                REQUIRE((*runs)[i].id == static_cast<int>(i));
+            }
+        }
+
+        auto p99 = [](std::vector<Run> runs, auto key) {
+            std::sort(runs.begin(), runs.end(), [&](const Run& a, const Run& b) { return key(a) < key(b); });
+            return key(runs[runs.size() * 99 / 100]);
+        };
+        auto by_position = [](const Run& run) { return run.position; };
+        auto by_latency = [](const Run& run) { return run.latency; };
+
+        // Background gets 1/5 of the worker next to UserInitiated (weights 1:4),
+        // so its tail ends well before the UserInitiated backlog drains.
+        REQUIRE(p99(low, by_position) < high.back().position * 3 / 4);
+        REQUIRE(p99(low, by_latency) < p99(high, by_latency));
+    }
+}
+
+TEST_CASE("ThreadPool reserved workers only run UserInteractive tasks", "[ThreadPool]") {
+    for (auto scheduler : {ThreadPool::Scheduler::GlobalQueue, ThreadPool::Scheduler::WorkStealing}) {
+        ThreadPool::Options options;
+        options.threads = 2;
+        options.scheduler = scheduler;
+        options.reserved_interactive = 1;
+        ThreadPool pool(options);
+
+        std::mutex mutex;
+        std::vector<std::thread::id> background;
+        std::atomic<bool> release{false};
+        std::atomic<int> done{0};
+        for (int i = 0; i < 50; i++) {
+            pool.submit([&] {
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    background.push_back(std::this_thread::get_id());
+                }
+                while (!release.load()) {
+                    std::this_thread::sleep_for(1ms);
+                }
+                done++;
+            }, ThreadPool::QoS::Background);
+        }
+
+        // The unreserved worker is stuck, the reserved one still serves UserInteractive.
+        std::atomic<bool> interactive{false};
+        pool.submit([&] { interactive = true; }, ThreadPool::QoS::UserInteractive);
+        REQUIRE(test_helpers::wait_until([&]{ return interactive.load(); }));
+
+        release = true;
+        REQUIRE(test_helpers::wait_until([&]{ return done.load() == 50; }, 5s));
+        std::lock_guard<std::mutex> lock(mutex);
+        REQUIRE(std::count(background.begin(), background.end(), background.front()) == 50);
+    }
+}
+
+TEST_CASE("ThreadPool metrics overhead", "[.][benchmark][ThreadPool]") {
+    constexpr int tasks = 10000;
+
+    auto run = [](ThreadPool& pool) {
+        std::atomic<int> counter{0};
+        for (size_t w = 0; w < pool.size(); w++) {
+            pool.submit([&] {
+                for (int i = 0; i < tasks; i++) {
+                    pool.submit([&]{ counter++; });
+                }
+            });
+        }
+        const int expected = tasks * static_cast<int>(pool.size());
+        while (counter.load() != expected) {
+            std::this_thread::yield();
+        }
+        return counter.load();
+    };
+
+    ThreadPool::Options options;
+
+    ThreadPool plain(options);
+    BENCHMARK("metrics off") { return run(plain); };
+
+    options.metrics = true;
+    ThreadPool measured(options);
+    BENCHMARK("metrics on") { return run(measured); };
+}
+
+TEST_CASE("ThreadPool capacity applies the overflow policy per level", "[ThreadPool]") {
+    const auto utility = static_cast<size_t>(ThreadPool::QoS::Utility);
+    for (auto [scheduler, overflow] : {
+             std::pair{ThreadPool::Scheduler::GlobalQueue, ThreadPool::Overflow::DropNewest},
+             std::pair{ThreadPool::Scheduler::GlobalQueue, ThreadPool::Overflow::DropOldest},
+             std::pair{ThreadPool::Scheduler::WorkStealing, ThreadPool::Overflow::DropOldest}}) {
+        ThreadPool::Options options;
+        options.threads = 1;
+        options.scheduler = scheduler;
+        options.capacity[utility] = 2;
+        options.overflow = overflow;
+        ThreadPool pool(options);
+
+        std::atomic<bool> started{false};
+        std::atomic<bool> release{false};
+        pool.submit([&] {
+            started = true;
+            while (!release.load()) {
+                std::this_thread::sleep_for(1ms);
+            }
+        });
+        REQUIRE(test_helpers::wait_until([&]{ return started.load(); }));
+
+        // Discarded tasks are released right away, so at most two are held.
+        std::mutex mutex;
+        std::vector<int> ran;
+        auto held = std::make_shared<int>(0);
+        for (int i = 0; i < 6; i++) {
+            pool.submit([&, i, held] {
+                std::lock_guard<std::mutex> lock(mutex);
+                ran.push_back(i);
+            });
+            REQUIRE(held.use_count() <= 3);
+        }
+        REQUIRE_FALSE(pool.try_submit([] {}));
+        // Other levels are not limited.
+        REQUIRE(pool.try_submit([] {}, ThreadPool::QoS::Background));
+
+        release = true;
+        REQUIRE(test_helpers::wait_until([&]{ return pool.stats().levels[utility].depth == 0; }));
+        REQUIRE(pool.stats().levels[utility].rejected == 5);
+        std::lock_guard<std::mutex> lock(mutex);
+        if (overflow == ThreadPool::Overflow::DropNewest) {
+            REQUIRE(ran == std::vector<int>{0, 1});
+        } else {
+            REQUIRE(ran == std::vector<int>{4, 5});
+        }
+    }
+}
+
+TEST_CASE("ThreadPool capacity blocks submitters until the level drains", "[ThreadPool]") {
+    const auto utility = static_cast<size_t>(ThreadPool::QoS::Utility);
+    ThreadPool::Options options;
+    options.threads = 1;
+    options.capacity[utility] = 2;
+    ThreadPool pool(options);
+
+    std::atomic<bool> started{false};
+    std::atomic<bool> release{false};
+    pool.submit([&] {
+        started = true;
+        while (!release.load()) {
+            std::this_thread::sleep_for(1ms);
+        }
+    });
+    REQUIRE(test_helpers::wait_until([&]{ return started.load(); }));
+
+    std::atomic<int> submitted{0};
+    std::atomic<int> done{0};
+    std::thread producer([&] {
+        for (int i = 0; i < 10; i++) {
+            pool.submit([&] { done++; });
+            submitted++;
+        }
+    });
+
+    REQUIRE(test_helpers::wait_until([&]{ return submitted.load() == 2; }));
+    std::this_thread::sleep_for(50ms);
+    REQUIRE(submitted.load() == 2);
+
+    release = true;
+    producer.join();
+    REQUIRE(test_helpers::wait_until([&]{ return done.load() == 10; }));
+    REQUIRE(pool.stats().levels[utility].rejected == 0);
+}
+
+TEST_CASE("ThreadPool with zero threads still runs tasks", "[ThreadPool]") {
+    ThreadPool::Options options;
+    options.threads = 0;
+    options.max_threads = 2;
+    ThreadPool pool(options);
+    std::atomic<int> counter{0};
+
+    pool.submit([&]{ counter++; });
+    pool.submit([&]{ counter++; }, ThreadPool::QoS::Background);
+
+    REQUIRE(test_helpers::wait_until([&]{ return counter.load() == 2; }));
+    REQUIRE(pool.size() >= 1);
+}
@@ -1,9 +1,15 @@
 #include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
 #include <TurboQ/timer.hpp>
 #include <TurboQ/queue.hpp>
 #include "test_helpers.hpp"
 
 #include <atomic>
+#include <functional>
+#include <memory>
+#include <queue>
+#include <random>
+#include <string>
 #include <vector>
 #include <chrono>
 #include <thread>
@@ -54,3 +60,368 @@ TEST_CASE("Timer does not execute before scheduled time", "[Timer]") {
 
     REQUIRE(test_helpers::wait_until([&]{ return executed.load(); }));
 }
+
+TEST_CASE("Timer wheel executes multiple tasks in correct order", "[Timer]") {
+    turboq::Timer sut(turboq::Timer::Backend::Wheel);
+    turboq::Queue queue("test", turboq::Queue::Type::Serial);
+
+    std::vector<int> order;
+    std::mutex m;
+
+    auto now = std::chrono::steady_clock::now();
+    sut.schedule([&] { std::lock_guard<std::mutex> l(m); order.push_back(1); }, now + 90ms, queue);
+    sut.schedule([&] { std::lock_guard<std::mutex> l(m); order.push_back(2); }, now + 10ms, queue);
+    sut.schedule([&] { std::lock_guard<std::mutex> l(m); order.push_back(3); }, now + 40ms, queue);
+
+    REQUIRE(test_helpers::wait_until([&]{ std::lock_guard<std::mutex> l(m); return order.size() == 3; }));
+
+    REQUIRE(order[0] == 2);
+    REQUIRE(order[1] == 3);
+    REQUIRE(order[2] == 1);
+}
+
+TEST_CASE("Timer wheel does not execute before scheduled time", "[Timer]") {
+    turboq::Timer sut(turboq::Timer::Backend::Wheel);
+    turboq::Queue queue("test", turboq::Queue::Type::Serial);
+    std::atomic<bool> executed{false};
+
+    auto when = std::chrono::steady_clock::now() + 200ms;
+    sut.schedule([&] { executed = true; }, when, queue);
+
+    bool not_executed_early = !test_helpers::wait_until([&]{ return executed.load(); }, 50ms);
+    REQUIRE(not_executed_early);
+
+    REQUIRE(test_helpers::wait_until([&]{ return executed.load(); }));
+    REQUIRE(std::chrono::steady_clock::now() >= when);
+}
+
+TEST_CASE("TimingWheel expires entries in deadline order across levels", "[Timer]") {
+    turboq::detail::TimingWheel<uint64_t> sut;
+    std::vector<uint64_t> deadlines = {0, 1, 63, 64, 65, 4095, 4096, 300000, 5000000, 90000000, 1ull << 40};
+    for (auto it = deadlines.rbegin(); it != deadlines.rend(); ++it) {
+        sut.insert(*it, *it);
+    }
+
+    std::vector<uint64_t> fired;
+    while (auto next = sut.next_expiration()) {
+        sut.advance(*next, [&](uint64_t deadline) {
+            REQUIRE(deadline <= *next);
+            fired.push_back(deadline);
+        });
+    }
+
+    REQUIRE(sut.empty());
+    REQUIRE(fired == deadlines);
+}
+
+TEST_CASE("TimingWheel advances in small steps without firing early", "[Timer]") {
+    turboq::detail::TimingWheel<uint64_t> sut;
+    for (uint64_t tick = 3; tick < 20000; tick += 37) {
+        sut.insert(tick, tick);
+    }
+
+    size_t fired = 0;
+    for (uint64_t now = 0; now < 20000; now += 5) {
+        sut.advance(now, [&](uint64_t deadline) {
+            REQUIRE(deadline <= now);
+            REQUIRE(deadline + 5 > now);
+            fired++;
+        });
+    }
+
+    REQUIRE(sut.empty());
+    REQUIRE(fired == (20000 - 3 + 36) / 37);
+}
+
+TEST_CASE("Timer handle cancels a pending task", "[Timer]") {
+    for (auto backend : {turboq::Timer::Backend::Heap, turboq::Timer::Backend::Wheel}) {
+        turboq::Timer sut(backend);
+        turboq::Queue queue("test", turboq::Queue::Type::Serial);
+        std::atomic<bool> executed{false};
+        auto captured = std::make_shared<int>(0);
+
+        auto handle = sut.schedule([&, captured] { executed = true; },
+                                   std::chrono::steady_clock::now() + 30ms, queue);
+
+        REQUIRE(handle.pending());
+        REQUIRE(handle.cancel());
+        REQUIRE_FALSE(handle.pending());
+        REQUIRE_FALSE(handle.cancel());
+        REQUIRE(captured.use_count() == 1);
+
+        bool fired = test_helpers::wait_until([&]{ return executed.load(); }, 100ms);
+        REQUIRE_FALSE(fired);
+        REQUIRE_FALSE(handle.reschedule(std::chrono::steady_clock::now()));
+    }
+}
+
+TEST_CASE("Timer handle reschedules a pending task", "[Timer]") {
+    for (auto backend : {turboq::Timer::Backend::Heap, turboq::Timer::Backend::Wheel}) {
+        turboq::Timer sut(backend);
+        turboq::Queue queue("test", turboq::Queue::Type::Serial);
+        std::atomic<int> executed{0};
+
+        auto start = std::chrono::steady_clock::now();
+        auto handle = sut.schedule([&] { executed++; }, start + 20ms, queue);
+        REQUIRE(handle.reschedule(start + 80ms));
+
+        REQUIRE_FALSE(test_helpers::wait_until([&]{ return executed.load() > 0; }, 50ms));
+        REQUIRE(test_helpers::wait_until([&]{ return executed.load() > 0; }));
+        REQUIRE(std::chrono::steady_clock::now() >= start + 80ms);
+
+        // The stale record from the first deadline must not run the task again.
+        std::this_thread::sleep_for(30ms);
+        REQUIRE(executed.load() == 1);
+        REQUIRE_FALSE(handle.pending());
+        REQUIRE_FALSE(handle.cancel());
+    }
+}
+
+TEST_CASE("Timer handle outlives its timer", "[Timer]") {
+    turboq::Queue queue("test", turboq::Queue::Type::Serial);
+    turboq::Timer::Handle handle;
+    {
+        turboq::Timer sut;
+        handle = sut.schedule([] {}, std::chrono::steady_clock::now() + 1h, queue);
+        REQUIRE(handle.pending());
+    }
+
+    REQUIRE_FALSE(handle.pending());
+    REQUIRE_FALSE(handle.reschedule(std::chrono::steady_clock::now()));
+}
+
+TEST_CASE("Timer purges cancelled records before they come due", "[Timer]") {
+    for (auto backend : {turboq::Timer::Backend::Heap, turboq::Timer::Backend::Wheel}) {
+        turboq::Timer sut(backend);
+        turboq::Queue queue("test", turboq::Queue::Type::Serial);
+        auto captured = std::make_shared<int>(0);
+
+        // A cancelled series keeps its task until the timer drops the record,
+        // so the captures show how many records are still stored.
+        for (int i = 0; i < 1000; i++) {
+            auto handle = sut.schedule_every([captured] {}, std::chrono::steady_clock::now() + 1h,
+                                             1h, queue);
+            REQUIRE(handle.cancel());
+        }
+        REQUIRE(captured.use_count() < 200);
+    }
+}
+
+TEST_CASE("Timer fires overlapping leeway windows in one wakeup", "[Timer]") {
+    constexpr int kTimers = 100;
+
+    for (auto backend : {turboq::Timer::Backend::Heap, turboq::Timer::Backend::Wheel}) {
+        turboq::Timer sut(backend);
+        turboq::Queue serial("leeway_serial", turboq::Queue::Type::Serial);
+        turboq::Queue concurrent("leeway_concurrent", turboq::Queue::Type::Concurrent);
+        std::atomic<int> executed{0};
+        std::atomic<bool> early{false};
+
+        // Deadlines spread over 20ms, each allowed to slip by 50ms.
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < kTimers; i++) {
+            auto when = start + 30ms + std::chrono::microseconds(i * 200);
+            auto& queue = i % 2 ? serial : concurrent;
+            sut.schedule([&, when] {
+                if (std::chrono::steady_clock::now() < when)
+                    early = true;
+                executed++;
+            }, when, queue, 50ms);
+        }
+
+        REQUIRE(test_helpers::wait_until([&]{ return executed.load() == kTimers; }));
+        REQUIRE_FALSE(early.load());
+        REQUIRE(sut.wakeups() <= 2);
+    }
+}
+
+TEST_CASE("Timer without leeway keeps one wakeup per distinct deadline", "[Timer]") {
+    turboq::Timer sut;
+    turboq::Queue queue("no_leeway", turboq::Queue::Type::Serial);
+    std::atomic<int> executed{0};
+
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < 5; i++) {
+        sut.schedule([&] { executed++; }, start + std::chrono::milliseconds(10 + i * 10), queue);
+    }
+
+    REQUIRE(test_helpers::wait_until([&]{ return executed.load() == 5; }));
+    // A late dispatch thread may take two due deadlines in one wakeup, but
+    // without leeway nothing is pulled forward to share one.
+    REQUIRE(sut.wakeups() <= 5);
+    REQUIRE(sut.wakeups() >= 2);
+}
+
+TEST_CASE("Timer periodic tasks stay on their grid", "[Timer]") {
+    constexpr int kRuns = 20;
+    constexpr auto kPeriod = 10ms;
+
+    for (auto backend : {turboq::Timer::Backend::Heap, turboq::Timer::Backend::Wheel}) {
+        turboq::Timer sut(backend);
+        turboq::Queue queue("every", turboq::Queue::Type::Concurrent);
+        std::atomic<int> runs{0};
+        std::atomic<int> active{0};
+        std::atomic<bool> overlapped{false};
+        std::atomic<bool> early{false};
+
+        // Each run takes most of a period; re-arming from the task would put
+        // run k at least k * 16ms after the first tick instead of k * 10ms.
+        auto first = std::chrono::steady_clock::now() + kPeriod;
+        auto handle = sut.schedule_every([&] {
+            if (++active > 1)
+                overlapped = true;
+            int run = runs.load();
+            if (run < kRuns && std::chrono::steady_clock::now() < first + run * kPeriod)
+                early = true;
+            std::this_thread::sleep_for(6ms);
+            runs++;
+            active--;
+        }, first, kPeriod, queue);
+
+        REQUIRE(test_helpers::wait_until([&]{ return runs.load() >= kRuns; }));
+        auto elapsed = std::chrono::steady_clock::now() - first;
+        REQUIRE(handle.cancel());
+        REQUIRE_FALSE(handle.pending());
+
+        REQUIRE_FALSE(early.load());
+        REQUIRE_FALSE(overlapped.load());
+        CHECK(elapsed < kRuns * 16ms);
+
+        // At most the run in flight at cancel() finishes afterwards.
+        int seen = runs.load();
+        REQUIRE_FALSE(test_helpers::wait_until([&]{ return runs.load() > seen + 1; }, 50ms));
+    }
+}
+
+TEST_CASE("Timer periodic tasks skip or catch up on missed ticks", "[Timer]") {
+    for (auto missed : {turboq::Timer::Missed::Skip, turboq::Timer::Missed::CatchUp}) {
+        auto sut = std::make_unique<turboq::Timer>();
+        turboq::Queue queue("every_missed", turboq::Queue::Type::Serial);
+        std::atomic<int> runs{0};
+        std::atomic<bool> open{false};
+        auto captured = std::make_shared<int>(0);
+
+        // Hold the queue past five ticks: the first queues a run, the others
+        // are dropped or owed to the queue. Once the marker has fired, the
+        // timer has claimed every tick up to it.
+        queue.async([&] {
+            while (!open.load()) {
+                std::this_thread::sleep_for(1ms);
+            }
+        });
+        auto first = std::chrono::steady_clock::now() + 5ms;
+        auto handle = sut->schedule_every([&, captured] { runs++; }, first, 5ms, queue, missed);
+        auto marker = sut->schedule([] {}, first + 20ms, queue);
+        REQUIRE(test_helpers::wait_until([&]{ return !marker.pending(); }));
+
+        // Without the timer no new ticks arrive; the entry is released once
+        // the queue has run everything it was owed.
+        sut.reset();
+        handle = turboq::Timer::Handle();
+        open = true;
+        REQUIRE(test_helpers::wait_until([&]{ return captured.use_count() == 1; }));
+
+        if (missed == turboq::Timer::Missed::CatchUp) {
+            REQUIRE(runs.load() >= 5);
+        } else {
+            REQUIRE(runs.load() == 1);
+        }
+    }
+}
+
+TEST_CASE("Timer periodic ticks do not allocate", "[Timer]") {
+    constexpr int kRuns = 30;
+    turboq::Timer sut;
+    turboq::Queue queue("every_alloc", turboq::Queue::Type::Serial);
+
+    // Allocations on the thread running the ticks, between two consecutive
+    // runs on it; the serial queue orders the runs, so plain variables do.
+    std::thread::id last_thread;
+    size_t last_count = 0;
+    size_t allocated = 0;
+    int measured = 0;
+    std::atomic<int> runs{0};
+
+    auto handle = sut.schedule_every([&] {
+        int run = runs.load();
+        if (run >= kRuns)
+            return;
+        size_t count = test_helpers::allocations;
+        // The first runs warm up the node and timer buffers.
+        if (run >= 5 && std::this_thread::get_id() == last_thread) {
+            allocated += count - last_count;
+            measured++;
+        }
+        last_thread = std::this_thread::get_id();
+        last_count = test_helpers::allocations;
+        runs++;
+    }, std::chrono::steady_clock::now(), 1ms, queue);
+
+    REQUIRE(test_helpers::wait_until([&]{ return runs.load() == kRuns; }));
+    handle.cancel();
+    REQUIRE(measured > 0);
+    REQUIRE(allocated == 0);
+}
+
+TEST_CASE("Timer backends with many pending timers", "[.][benchmark][Timer]") {
+    turboq::Queue queue("bench", turboq::Queue::Type::Concurrent);
+
+    for (size_t pending : {1000, 10000, 100000, 1000000}) {
+        for (auto backend : {turboq::Timer::Backend::Heap, turboq::Timer::Backend::Wheel}) {
+            turboq::Timer sut(backend);
+            std::mt19937 rng(42);
+            std::uniform_int_distribution<int> delay(1000, 600000);
+
+            auto now = std::chrono::steady_clock::now();
+            for (size_t i = 0; i < pending; i++) {
+                sut.schedule([] {}, now + std::chrono::milliseconds(delay(rng)), queue);
+            }
+
+            std::string name = backend == turboq::Timer::Backend::Heap ? "Heap" : "Wheel";
+            BENCHMARK_ADVANCED(name + " schedule x1000, " + std::to_string(pending) + " pending")(Catch::Benchmark::Chronometer meter) {
+                meter.measure([&] {
+                    for (int i = 0; i < 1000; i++) {
+                        sut.schedule([] {}, now + std::chrono::milliseconds(delay(rng)), queue);
+                    }
+                });
+            };
+        }
+    }
+}
+
+TEST_CASE("Timer storage insert and expiry churn", "[.][benchmark][Timer]") {
+    for (uint64_t pending : {1000, 10000, 100000, 1000000}) {
+        BENCHMARK_ADVANCED("Heap churn x1000, " + std::to_string(pending) + " pending")(Catch::Benchmark::Chronometer meter) {
+            std::priority_queue<uint64_t, std::vector<uint64_t>, std::greater<>> heap;
+            uint64_t now = 0;
+            for (uint64_t i = 0; i < pending; i++) heap.push(now + 1 + i % 60000);
+
+            meter.measure([&] {
+                for (int i = 0; i < 1000; i++) {
+                    now++;
+                    while (!heap.empty() && heap.top() <= now) {
+                        heap.pop();
+                        heap.push(now + 60000);
+                    }
+                    heap.push(now + 60000);
+                }
+            });
+        };
+
+        BENCHMARK_ADVANCED("Wheel churn x1000, " + std::to_string(pending) + " pending")(Catch::Benchmark::Chronometer meter) {
+            turboq::detail::TimingWheel<uint64_t> wheel;
+            uint64_t now = 0;
+            for (uint64_t i = 0; i < pending; i++) wheel.insert(now + 1 + i % 60000, 0);
+
+            meter.measure([&] {
+                for (int i = 0; i < 1000; i++) {
+                    now++;
+                    size_t expired = 0;
+                    wheel.advance(now, [&](uint64_t) { expired++; });
+                    for (size_t e = 0; e < expired; e++) wheel.insert(now + 60000, 0);
+                    wheel.insert(now + 60000, 0);
+                }
+            });
+        };
+    }
+}